@@ -0,0 +1,174 @@
+#ifndef DASHBOARD_SHM_HPP
+#define DASHBOARD_SHM_HPP
+
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "latency_tracker.hpp"
+
+// Shared-memory dashboard publication.
+//
+// The trading process is the single writer: it fills a fixed-size POD
+// snapshot and publishes it into a seqlock-protected shared-memory segment —
+// two relaxed-cost atomic bumps around a memcpy, wait-free, no allocation,
+// no file I/O, no syscall after setup. The dashboard is a separate reader
+// process that maps the segment read-only and retries the seqlock until it
+// observes a torn-free copy. Monitoring can attach, detach, crash, or fall
+// behind without the trading process ever noticing.
+
+inline constexpr const char* DASHBOARD_SHM_NAME = "/hft_dashboard";
+inline constexpr uint32_t DASHBOARD_SHM_MAGIC = 0x48445342;  // "HDSB"
+inline constexpr uint32_t DASHBOARD_SHM_VERSION = 1;
+
+// Fixed-layout snapshot: no vectors, no pointers — it is memcpy'd across the
+// process boundary. Counts say how many array slots are live.
+struct DashboardSnapshot {
+    uint64_t publish_ts_ns = 0;  // Writer's clock at publish time
+    uint64_t sequence = 0;       // Monotonic snapshot number
+
+    uint32_t market_price_count = 0;
+    uint32_t performance_metric_count = 0;
+    double market_prices[32] = {};
+    double performance_metrics[16] = {};
+
+    double risk_exposure = 0.0;
+    double latency = 0.0;  // Legacy scalar: tick-to-trade p50, in ms
+    double volatility = 0.0;
+    double spread = 0.0;
+
+    LatencySnapshot latency_stages[static_cast<int>(LatencyStage::STAGE_COUNT)];
+};
+
+static_assert(std::is_trivially_copyable<DashboardSnapshot>::value,
+              "Snapshot crosses a process boundary as raw bytes");
+
+// The mapped segment: header identifying layout, seqlock word, snapshot.
+struct DashboardSegment {
+    uint32_t magic;
+    uint32_t version;
+    std::atomic<uint32_t> seq;  // Odd while a write is in flight
+    DashboardSnapshot snapshot;
+};
+
+// Writer side — lives in the trading process. create() is the only place
+// that touches the filesystem; publish() is wait-free.
+class DashboardPublisher {
+public:
+    // Create (or reuse) the segment. Call once at startup, before the hot
+    // path is live.
+    bool create(const char* name = DASHBOARD_SHM_NAME) {
+        const int fd = shm_open(name, O_CREAT | O_RDWR, 0644);
+        if (fd < 0) {
+            return false;
+        }
+        if (ftruncate(fd, sizeof(DashboardSegment)) != 0) {
+            close(fd);
+            return false;
+        }
+        void* mem = mmap(nullptr, sizeof(DashboardSegment), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        close(fd);
+        if (mem == MAP_FAILED) {
+            return false;
+        }
+        segment_ = static_cast<DashboardSegment*>(mem);
+        segment_->seq.store(0, std::memory_order_relaxed);
+        segment_->version = DASHBOARD_SHM_VERSION;
+        segment_->magic = DASHBOARD_SHM_MAGIC;  // Written last: readers key off it
+        return true;
+    }
+
+    // Seqlock publish: bump to odd (write in flight), copy, bump to even.
+    // Single writer only; wait-free regardless of reader behavior.
+    void publish(const DashboardSnapshot& snapshot) {
+        if (segment_ == nullptr) {
+            return;
+        }
+        const uint32_t seq = segment_->seq.load(std::memory_order_relaxed);
+        segment_->seq.store(seq + 1, std::memory_order_release);
+        std::atomic_thread_fence(std::memory_order_release);
+        segment_->snapshot = snapshot;
+        segment_->snapshot.sequence = next_sequence_++;
+        std::atomic_thread_fence(std::memory_order_release);
+        segment_->seq.store(seq + 2, std::memory_order_release);
+    }
+
+    void destroy(const char* name = DASHBOARD_SHM_NAME) {
+        if (segment_ != nullptr) {
+            munmap(segment_, sizeof(DashboardSegment));
+            segment_ = nullptr;
+        }
+        shm_unlink(name);
+    }
+
+    ~DashboardPublisher() {
+        if (segment_ != nullptr) {
+            munmap(segment_, sizeof(DashboardSegment));
+        }
+    }
+
+private:
+    DashboardSegment* segment_ = nullptr;
+    uint64_t next_sequence_ = 1;
+};
+
+// Reader side — lives in the dashboard process. Maps read-only; read()
+// retries until it gets a torn-free snapshot.
+class DashboardReader {
+public:
+    bool open(const char* name = DASHBOARD_SHM_NAME) {
+        const int fd = shm_open(name, O_RDONLY, 0);
+        if (fd < 0) {
+            return false;
+        }
+        void* mem = mmap(nullptr, sizeof(DashboardSegment), PROT_READ, MAP_SHARED, fd, 0);
+        close(fd);
+        if (mem == MAP_FAILED) {
+            return false;
+        }
+        segment_ = static_cast<const DashboardSegment*>(mem);
+        if (segment_->magic != DASHBOARD_SHM_MAGIC || segment_->version != DASHBOARD_SHM_VERSION) {
+            munmap(const_cast<DashboardSegment*>(segment_), sizeof(DashboardSegment));
+            segment_ = nullptr;
+            return false;
+        }
+        return true;
+    }
+
+    // Copy out the latest consistent snapshot. Returns false if the writer
+    // has not published yet or the read keeps colliding with writes.
+    bool read(DashboardSnapshot& out, int max_retries = 64) const {
+        if (segment_ == nullptr) {
+            return false;
+        }
+        for (int attempt = 0; attempt < max_retries; ++attempt) {
+            const uint32_t before = segment_->seq.load(std::memory_order_acquire);
+            if (before == 0 || (before & 1u) != 0) {
+                continue;  // Nothing published yet, or a write is in flight
+            }
+            out = segment_->snapshot;
+            std::atomic_thread_fence(std::memory_order_acquire);
+            const uint32_t after = segment_->seq.load(std::memory_order_acquire);
+            if (before == after) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    ~DashboardReader() {
+        if (segment_ != nullptr) {
+            munmap(const_cast<DashboardSegment*>(segment_), sizeof(DashboardSegment));
+        }
+    }
+
+private:
+    const DashboardSegment* segment_ = nullptr;
+};
+
+#endif  // DASHBOARD_SHM_HPP
@@ -0,0 +1,217 @@
+#ifndef LATENCY_TRACKER_HPP
+#define LATENCY_TRACKER_HPP
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <thread>
+
+#if defined(__x86_64__) || defined(_M_X64)
+#include <x86intrin.h>
+#endif
+
+// Tick-to-trade latency instrumentation.
+//
+// Hot threads stamp hop points with rdtsc (one instruction, no syscall) and
+// record the hop interval into a lock-free HDR-style histogram: bucketed by
+// the value's log2 range with 32 linear sub-buckets each, so relative error
+// stays within ~3% across nine decades while record() is two bit scans and
+// one relaxed fetch_add. A monitoring thread snapshots the buckets off the
+// hot path and reads p50/p99/p99.9/max per stage — the tail, not an average,
+// is what we tune against.
+
+// Raw cycle counter for hop timestamps.
+inline uint64_t rdtsc_now() {
+#if defined(__x86_64__) || defined(_M_X64)
+    return __rdtsc();
+#else
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+#endif
+}
+
+// Pipeline stages, each the interval between two adjacent hop points:
+// connector rx -> strategy signal -> createOrder entry -> connector send ->
+// exchange ack, plus the whole tick-to-trade span.
+enum class LatencyStage {
+    RX_TO_SIGNAL = 0,   // Connector rx timestamp -> strategy signal decision
+    SIGNAL_TO_CREATE,   // Signal decision -> OrderManager::createOrder entry
+    CREATE_TO_SEND,     // createOrder entry -> ExchangeConnector send
+    SEND_TO_ACK,        // Wire send -> exchange ack rx
+    TICK_TO_TRADE,      // Connector rx -> wire send, end to end
+    STAGE_COUNT
+};
+
+inline const char* latencyStageName(LatencyStage stage) {
+    switch (stage) {
+        case LatencyStage::RX_TO_SIGNAL: return "rx->signal";
+        case LatencyStage::SIGNAL_TO_CREATE: return "signal->create";
+        case LatencyStage::CREATE_TO_SEND: return "create->send";
+        case LatencyStage::SEND_TO_ACK: return "send->ack";
+        case LatencyStage::TICK_TO_TRADE: return "tick->trade";
+        default: return "unknown";
+    }
+}
+
+// Percentile snapshot for one stage, in nanoseconds.
+struct LatencySnapshot {
+    uint64_t count = 0;
+    uint64_t p50_ns = 0;
+    uint64_t p99_ns = 0;
+    uint64_t p999_ns = 0;
+    uint64_t max_ns = 0;
+};
+
+// Lock-free HDR-style histogram of nanosecond values. Writers only do
+// relaxed atomic increments; readers walk the buckets. Range: 1ns to ~4s.
+class LatencyHistogram {
+public:
+    static constexpr int SUB_BUCKET_BITS = 5;  // 32 linear sub-buckets per power of two
+    static constexpr int SUB_BUCKETS = 1 << SUB_BUCKET_BITS;
+    static constexpr int BUCKETS = 32;         // log2 ranges: covers up to ~4.3e9 ns
+    static constexpr int SLOTS = BUCKETS * SUB_BUCKETS;
+
+    // Record one value. Any thread, wait-free.
+    void record(uint64_t value_ns) {
+        counts_[slotFor(value_ns)].fetch_add(1, std::memory_order_relaxed);
+        // Track the true max separately — bucketing rounds it.
+        uint64_t seen = max_ns_.load(std::memory_order_relaxed);
+        while (value_ns > seen &&
+               !max_ns_.compare_exchange_weak(seen, value_ns, std::memory_order_relaxed)) {
+        }
+    }
+
+    // Percentile snapshot. Monitoring thread; concurrent records may or may
+    // not be included, which is fine for a periodic publisher.
+    LatencySnapshot snapshot() const {
+        std::array<uint64_t, SLOTS> counts;
+        uint64_t total = 0;
+        for (int i = 0; i < SLOTS; ++i) {
+            counts[i] = counts_[i].load(std::memory_order_relaxed);
+            total += counts[i];
+        }
+        LatencySnapshot snap;
+        snap.count = total;
+        if (total == 0) {
+            return snap;
+        }
+        snap.p50_ns = valueAtRank(counts, (total * 50 + 99) / 100);
+        snap.p99_ns = valueAtRank(counts, (total * 99 + 99) / 100);
+        snap.p999_ns = valueAtRank(counts, (total * 999 + 999) / 1000);
+        snap.max_ns = max_ns_.load(std::memory_order_relaxed);
+        return snap;
+    }
+
+    void reset() {
+        for (auto& c : counts_) {
+            c.store(0, std::memory_order_relaxed);
+        }
+        max_ns_.store(0, std::memory_order_relaxed);
+    }
+
+private:
+    static int slotFor(uint64_t value_ns) {
+        if (value_ns < SUB_BUCKETS) {
+            return static_cast<int>(value_ns);  // Exact below 32ns
+        }
+        const int log2v = 63 - __builtin_clzll(value_ns);
+        const int bucket = log2v - SUB_BUCKET_BITS + 1;
+        const int sub = static_cast<int>((value_ns >> (log2v - SUB_BUCKET_BITS)) & (SUB_BUCKETS - 1));
+        const int slot = bucket * SUB_BUCKETS + sub;
+        return slot < SLOTS ? slot : SLOTS - 1;
+    }
+
+    // Lowest representative value of a slot (inverse of slotFor).
+    static uint64_t slotValue(int slot) {
+        const int bucket = slot / SUB_BUCKETS;
+        const int sub = slot % SUB_BUCKETS;
+        if (bucket == 0) {
+            return static_cast<uint64_t>(sub);
+        }
+        const int shift = bucket - 1;
+        return (static_cast<uint64_t>(SUB_BUCKETS + sub)) << shift;
+    }
+
+    static uint64_t valueAtRank(const std::array<uint64_t, SLOTS>& counts, uint64_t rank) {
+        uint64_t seen = 0;
+        for (int i = 0; i < SLOTS; ++i) {
+            seen += counts[i];
+            if (seen >= rank) {
+                return slotValue(i);
+            }
+        }
+        return slotValue(SLOTS - 1);
+    }
+
+    std::array<std::atomic<uint64_t>, SLOTS> counts_{};
+    std::atomic<uint64_t> max_ns_{0};
+};
+
+// One histogram per pipeline stage plus the tsc->ns conversion. Hop code
+// stamps rdtsc_now() at each point and hands adjacent pairs to record().
+class LatencyTracker {
+public:
+    static LatencyTracker& instance() {
+        static LatencyTracker tracker;
+        return tracker;
+    }
+
+    // Record one hop given its two raw tsc stamps.
+    void record(LatencyStage stage, uint64_t start_tsc, uint64_t end_tsc) {
+        if (end_tsc > start_tsc) {
+            histogram(stage).record(tscToNs(end_tsc - start_tsc));
+        }
+    }
+
+    // Record an interval already in nanoseconds.
+    void recordNs(LatencyStage stage, uint64_t ns) {
+        histogram(stage).record(ns);
+    }
+
+    LatencySnapshot snapshot(LatencyStage stage) const {
+        return histograms_[static_cast<int>(stage)].snapshot();
+    }
+
+    void reset() {
+        for (auto& h : histograms_) {
+            h.reset();
+        }
+    }
+
+    uint64_t tscToNs(uint64_t ticks) const {
+#if defined(__x86_64__) || defined(_M_X64)
+        return static_cast<uint64_t>(static_cast<double>(ticks) * ns_per_tick_);
+#else
+        return ticks;  // Fallback clock already returns nanoseconds
+#endif
+    }
+
+private:
+    LatencyTracker() { calibrate(); }
+
+    LatencyHistogram& histogram(LatencyStage stage) {
+        return histograms_[static_cast<int>(stage)];
+    }
+
+    // Measure the tsc rate once against the steady clock. 10ms of spin at
+    // startup buys ~0.1% conversion accuracy, plenty for histograms.
+    void calibrate() {
+#if defined(__x86_64__) || defined(_M_X64)
+        const auto wall_start = std::chrono::steady_clock::now();
+        const uint64_t tsc_start = rdtsc_now();
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        const uint64_t tsc_end = rdtsc_now();
+        const auto wall_end = std::chrono::steady_clock::now();
+        const auto wall_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(wall_end - wall_start).count();
+        if (tsc_end > tsc_start && wall_ns > 0) {
+            ns_per_tick_ = static_cast<double>(wall_ns) / static_cast<double>(tsc_end - tsc_start);
+        }
+#endif
+    }
+
+    std::array<LatencyHistogram, static_cast<int>(LatencyStage::STAGE_COUNT)> histograms_;
+    double ns_per_tick_ = 1.0;
+};
+
+#endif  // LATENCY_TRACKER_HPP
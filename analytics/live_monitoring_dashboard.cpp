@@ -1,194 +1,141 @@
 #include <iostream>
-#include <vector>
 #include <string>
 #include <chrono>
 #include <thread>
-#include <mutex>
 #include <atomic>
 #include <fstream>
-#include <pybind11/embed.h> 
-#include <jni.h> 
+#include "dashboard_shm.hpp"
+#include "latency_tracker.hpp"
+
+// Live monitoring dashboard — reader process.
+//
+// The dashboard no longer lives inside the trading process: the trading side
+// publishes a versioned DashboardSnapshot into a seqlock-protected shared
+// memory segment (DashboardPublisher in dashboard_shm.hpp, wait-free for the
+// writer), and this binary maps the segment read-only and renders it. The
+// six fetch threads serializing on one mutex are gone, and nothing here can
+// ever block, slow, or allocate inside the trading process — this program
+// can crash or fall behind and trading never notices.
 
 std::atomic<bool> running(true);
-std::mutex data_mutex;
 
-// Structure to hold live market and strategy data
-struct DashboardData {
-    std::vector<double> market_prices;
-    std::vector<double> performance_metrics;
-    double risk_exposure;
-    double latency;
-    double volatility;
-    double spread;
+constexpr int LATENCY_STAGES = static_cast<int>(LatencyStage::STAGE_COUNT);
+
+// Per-stage p99.9 budgets in nanoseconds — the thresholds we actually tune
+// against, replacing the old scalar "latency > 500" warning.
+constexpr uint64_t LATENCY_P999_BUDGET_NS[LATENCY_STAGES] = {
+    5000,     // rx->signal
+    2000,     // signal->create
+    3000,     // create->send
+    500000,   // send->ack (includes the wire and the exchange)
+    15000,    // tick->trade
 };
 
-// Function to log data to file
-void logData(const DashboardData& data) {
-    std::ofstream log_file("dashboard_log.txt", std::ios_base::app);
+// Function to log data to file. The stream is opened once and reused — this
+// runs in the dashboard process, but reopening a file several times per
+// 100ms was waste wherever it runs.
+void logData(const DashboardSnapshot& data) {
+    static std::ofstream log_file("dashboard_log.txt", std::ios_base::app);
     if (log_file.is_open()) {
-        log_file << "------ Log Entry ------\n";
+        log_file << "------ Log Entry (snapshot " << data.sequence << ") ------\n";
         log_file << "Market Prices: ";
-        for (const auto& price : data.market_prices) {
-            log_file << price << " ";
+        for (uint32_t i = 0; i < data.market_price_count; ++i) {
+            log_file << data.market_prices[i] << " ";
         }
         log_file << "\nPerformance Metrics: ";
-        for (const auto& metric : data.performance_metrics) {
-            log_file << metric << " ";
+        for (uint32_t i = 0; i < data.performance_metric_count; ++i) {
+            log_file << data.performance_metrics[i] << " ";
         }
         log_file << "\nRisk Exposure: " << data.risk_exposure << "\n";
         log_file << "Latency: " << data.latency << " ms\n";
+        for (int i = 0; i < LATENCY_STAGES; ++i) {
+            const LatencySnapshot& s = data.latency_stages[i];
+            log_file << "Stage " << latencyStageName(static_cast<LatencyStage>(i))
+                     << ": p50=" << s.p50_ns << "ns p99=" << s.p99_ns
+                     << "ns p99.9=" << s.p999_ns << "ns max=" << s.max_ns
+                     << "ns n=" << s.count << "\n";
+        }
         log_file << "Volatility: " << data.volatility << "\n";
         log_file << "Spread: " << data.spread << "\n";
         log_file << "-----------------------\n";
-    }
-    log_file.close();
-}
-
-// Function to fetch live market data
-void fetchMarketData(DashboardData& data) {
-    while (running) {
-        std::lock_guard<std::mutex> lock(data_mutex);
-        data.market_prices = getLiveMarketData();
-        data.volatility = getMarketVolatility();  // Fetching volatility metric
-        data.spread = getMarketSpread();          // Fetching bid-ask spread
-        logData(data);  // Log the fetched data
-        std::this_thread::sleep_for(std::chrono::milliseconds(100)); // Simulate real-time feed delay
-    }
-}
-
-// Function to fetch live strategy performance data
-void fetchPerformanceData(DashboardData& data) {
-    while (running) {
-        std::lock_guard<std::mutex> lock(data_mutex);
-        data.performance_metrics = getStrategyPerformance();
-        logData(data);  // Log the performance data
-        std::this_thread::sleep_for(std::chrono::milliseconds(200)); // Simulate data update interval
+        log_file.flush();
     }
 }
 
-// Function to fetch live risk exposure data
-void fetchRiskData(DashboardData& data) {
-    while (running) {
-        std::lock_guard<std::mutex> lock(data_mutex);
-        data.risk_exposure = getRiskExposure();
-        logData(data);  // Log the risk data
-        std::this_thread::sleep_for(std::chrono::milliseconds(300)); // Simulate real-time risk management update
-    }
-}
-
-// Function to monitor execution latency
-void monitorLatency(DashboardData& data) {
-    while (running) {
-        std::lock_guard<std::mutex> lock(data_mutex);
-        data.latency = getExecutionLatency();
-        logData(data);  // Log the latency data
-        std::this_thread::sleep_for(std::chrono::milliseconds(150)); // Simulate latency monitoring interval
-    }
-}
-
-// Function to generate random warnings based on risk exposure and volatility
-void generateWarnings(const DashboardData& data) {
+// Function to generate warnings based on risk exposure and volatility
+void generateWarnings(const DashboardSnapshot& data) {
     if (data.risk_exposure > 1000000) {
         std::cerr << "WARNING: Risk exposure exceeded safe limits!" << std::endl;
     }
     if (data.volatility > 2.5) {
         std::cerr << "WARNING: Market volatility is very high!" << std::endl;
     }
-    if (data.latency > 500) {
-        std::cerr << "WARNING: Execution latency is too high!" << std::endl;
-    }
-}
-
-// Function to display real-time data on the dashboard
-void displayDashboard(DashboardData& data) {
-    while (running) {
-        std::lock_guard<std::mutex> lock(data_mutex);
-        std::cout << "------ Live Monitoring Dashboard ------\n";
-        std::cout << "Market Prices: ";
-        for (const auto& price : data.market_prices) {
-            std::cout << price << " ";
-        }
-        std::cout << "\nPerformance Metrics: ";
-        for (const auto& metric : data.performance_metrics) {
-            std::cout << metric << " ";
+    // Latency alarms fire on the per-hop p99.9, not an average: a healthy
+    // median with a blown tail is exactly the failure mode we care about.
+    for (int i = 0; i < LATENCY_STAGES; ++i) {
+        const LatencySnapshot& s = data.latency_stages[i];
+        if (s.count > 0 && s.p999_ns > LATENCY_P999_BUDGET_NS[i]) {
+            std::cerr << "WARNING: " << latencyStageName(static_cast<LatencyStage>(i))
+                      << " p99.9 " << s.p999_ns << "ns exceeds budget "
+                      << LATENCY_P999_BUDGET_NS[i] << "ns!" << std::endl;
         }
-        std::cout << "\nRisk Exposure: " << data.risk_exposure << "\n";
-        std::cout << "Latency: " << data.latency << " ms\n";
-        std::cout << "Volatility: " << data.volatility << "\n";
-        std::cout << "Spread: " << data.spread << "\n";
-        std::cout << "---------------------------------------\n";
-        
-        generateWarnings(data);  // Check for warnings
-        std::this_thread::sleep_for(std::chrono::seconds(1)); // Update dashboard every second
     }
 }
 
-// Extended data fetching for deeper market conditions
-void fetchAdditionalMetrics(DashboardData& data) {
-    while (running) {
-        std::lock_guard<std::mutex> lock(data_mutex);
-        data.volatility = getMarketVolatility();   // Simulate fetching market volatility
-        data.spread = getMarketSpread();           // Simulate fetching market bid-ask spread
-        std::this_thread::sleep_for(std::chrono::milliseconds(500)); // Update additional metrics periodically
+// Render one snapshot to the console.
+void displayDashboard(const DashboardSnapshot& data) {
+    const auto now_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+    const double age_ms = (now_ns - static_cast<int64_t>(data.publish_ts_ns)) / 1e6;
+
+    std::cout << "------ Live Monitoring Dashboard ------\n";
+    std::cout << "Snapshot " << data.sequence << " (" << age_ms << " ms old)\n";
+    std::cout << "Market Prices: ";
+    for (uint32_t i = 0; i < data.market_price_count; ++i) {
+        std::cout << data.market_prices[i] << " ";
     }
-}
-
-// Function to display extended data on the dashboard
-void displayExtendedMetrics(const DashboardData& data) {
-    std::cout << "Additional Metrics:\n";
-    std::cout << "Market Volatility: " << data.volatility << "\n";
-    std::cout << "Bid-Ask Spread: " << data.spread << "\n";
-}
-
-// Extended real-time data display with logging and additional metrics
-void displayCompleteDashboard(DashboardData& data) {
-    while (running) {
-        std::lock_guard<std::mutex> lock(data_mutex);
-        std::cout << "****** Complete Live Monitoring Dashboard ******\n";
-        std::cout << "Market Prices: ";
-        for (const auto& price : data.market_prices) {
-            std::cout << price << " ";
-        }
-        std::cout << "\nPerformance Metrics: ";
-        for (const auto& metric : data.performance_metrics) {
-            std::cout << metric << " ";
-        }
-        std::cout << "\nRisk Exposure: " << data.risk_exposure << "\n";
-        std::cout << "Latency: " << data.latency << " ms\n";
-        std::cout << "Volatility: " << data.volatility << "\n";
-        std::cout << "Spread: " << data.spread << "\n";
-        std::cout << "***********************************************\n";
-        
-        generateWarnings(data);  // Generate warning messages
-        logData(data);  // Log the data to file for historical tracking
-        displayExtendedMetrics(data);  // Display extended metrics
-        
-        std::this_thread::sleep_for(std::chrono::seconds(1)); // Update dashboard every second
+    std::cout << "\nPerformance Metrics: ";
+    for (uint32_t i = 0; i < data.performance_metric_count; ++i) {
+        std::cout << data.performance_metrics[i] << " ";
     }
+    std::cout << "\nRisk Exposure: " << data.risk_exposure << "\n";
+    std::cout << "Latency: " << data.latency << " ms\n";
+    for (int i = 0; i < LATENCY_STAGES; ++i) {
+        const LatencySnapshot& s = data.latency_stages[i];
+        std::cout << "  " << latencyStageName(static_cast<LatencyStage>(i))
+                  << ": p50=" << s.p50_ns << "ns p99=" << s.p99_ns
+                  << "ns p99.9=" << s.p999_ns << "ns max=" << s.max_ns << "ns\n";
+    }
+    std::cout << "Volatility: " << data.volatility << "\n";
+    std::cout << "Spread: " << data.spread << "\n";
+    std::cout << "---------------------------------------\n";
+
+    generateWarnings(data);  // Check for warnings
 }
 
 int main() {
-    DashboardData dashboard_data;
+    DashboardReader reader;
 
-    // Launch threads for live data monitoring
-    std::thread market_data_thread(fetchMarketData, std::ref(dashboard_data));
-    std::thread performance_data_thread(fetchPerformanceData, std::ref(dashboard_data));
-    std::thread risk_data_thread(fetchRiskData, std::ref(dashboard_data));
-    std::thread latency_monitor_thread(monitorLatency, std::ref(dashboard_data));
-    std::thread additional_metrics_thread(fetchAdditionalMetrics, std::ref(dashboard_data));
-    std::thread display_thread(displayCompleteDashboard, std::ref(dashboard_data));
+    // Wait for the trading process to create the segment.
+    std::cout << "Attaching to " << DASHBOARD_SHM_NAME << "..." << std::endl;
+    while (running && !reader.open()) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(500));
+    }
+    std::cout << "Attached." << std::endl;
 
-    // Run the dashboard for a defined duration (60 seconds)
-    std::this_thread::sleep_for(std::chrono::seconds(60));
-    running = false;
+    DashboardSnapshot snapshot;
+    uint64_t last_sequence = 0;
 
-    // Wait for all threads to finish
-    market_data_thread.join();
-    performance_data_thread.join();
-    risk_data_thread.join();
-    latency_monitor_thread.join();
-    additional_metrics_thread.join();
-    display_thread.join();
+    // Run the dashboard for a defined duration (60 seconds)
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(60);
+    while (running && std::chrono::steady_clock::now() < deadline) {
+        if (reader.read(snapshot) && snapshot.sequence != last_sequence) {
+            last_sequence = snapshot.sequence;
+            displayDashboard(snapshot);
+            logData(snapshot);  // Log the data to file for historical tracking
+        }
+        std::this_thread::sleep_for(std::chrono::seconds(1));  // Update dashboard every second
+    }
 
     return 0;
-}
\ No newline at end of file
+}
@@ -0,0 +1,205 @@
+#ifndef METRICS_REGISTRY_HPP
+#define METRICS_REGISTRY_HPP
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <thread>
+
+#include "dashboard_shm.hpp"
+
+// Wait-free metrics counters.
+//
+// A counter shared between the trading loop and a display thread is both a
+// data race and, once several threads bump it per tick, a cache-line
+// battleground. Here every thread increments its own padded slab: a bump is
+// one relaxed load/store pair on a line no other core writes — no lock
+// prefix, no sharing, ever. A background aggregator walks the slabs
+// periodically, sums each counter across threads, and publishes the totals
+// into the DashboardSnapshot's performance_metrics block over the
+// shared-memory seqlock (dashboard_shm.hpp). Reads are therefore a little
+// stale and never exact-at-an-instant, which is the right trade for
+// monitoring.
+//
+// Registration: components call registerCounter("name") once at startup and
+// keep the returned Counter handle; the aggregator picks new counters up
+// automatically, so adding one never touches the aggregation code. Slabs
+// are allocated on a thread's first increment and pushed onto an intrusive
+// list; they are deliberately never freed, so counts from exited threads
+// keep contributing to the totals.
+
+using MetricId = uint32_t;
+
+class MetricsRegistry {
+public:
+    static constexpr uint32_t MAX_COUNTERS = 64;
+    static constexpr uint32_t MAX_NAME = 48;
+
+    static MetricsRegistry& instance() {
+        static MetricsRegistry registry;
+        return registry;
+    }
+
+    // Register (or look up) a counter by name. Call at startup, not on the
+    // hot path — it CASes the shared counter count.
+    MetricId registerCounter(const char* name) {
+        // Idempotent: a second registration of the same name returns the
+        // existing id, so two components can share a counter.
+        const uint32_t existing = count_.load(std::memory_order_acquire);
+        for (uint32_t i = 0; i < existing; ++i) {
+            if (std::strncmp(names_[i], name, MAX_NAME) == 0) {
+                return i;
+            }
+        }
+        const uint32_t id = count_.fetch_add(1, std::memory_order_acq_rel);
+        if (id >= MAX_COUNTERS) {
+            count_.store(MAX_COUNTERS, std::memory_order_release);
+            return MAX_COUNTERS - 1;  // Overflow bucket; widen MAX_COUNTERS
+        }
+        std::strncpy(names_[id], name, MAX_NAME - 1);
+        names_[id][MAX_NAME - 1] = '\0';
+        return id;
+    }
+
+    // Hot path: one uncontended increment on this thread's own cache line.
+    // The slab is single-writer, so a relaxed load/store pair suffices — no
+    // atomic RMW, no lock prefix.
+    void add(MetricId id, int64_t delta) {
+        std::atomic<uint64_t>& cell = slab().counters[id].value;
+        cell.store(cell.load(std::memory_order_relaxed) + static_cast<uint64_t>(delta),
+                   std::memory_order_relaxed);
+    }
+
+    // Sum a counter across all thread slabs. Deltas are added in two's
+    // complement, so signed accumulations (profit) read back correctly
+    // through the cast.
+    int64_t sum(MetricId id) const {
+        uint64_t total = 0;
+        for (const ThreadSlab* slab = slabs_.load(std::memory_order_acquire);
+             slab != nullptr; slab = slab->next) {
+            total += slab->counters[id].value.load(std::memory_order_relaxed);
+        }
+        return static_cast<int64_t>(total);
+    }
+
+    uint32_t counterCount() const { return count_.load(std::memory_order_acquire); }
+
+    const char* counterName(MetricId id) const {
+        return id < MAX_COUNTERS ? names_[id] : "?";
+    }
+
+    // Sum every registered counter into the snapshot's performance_metrics
+    // block (first MAX snapshot slots; the dashboard indexes them in
+    // registration order).
+    void aggregateInto(DashboardSnapshot& snapshot) const {
+        uint32_t n = counterCount();
+        constexpr uint32_t SNAPSHOT_SLOTS =
+            sizeof(snapshot.performance_metrics) / sizeof(snapshot.performance_metrics[0]);
+        if (n > SNAPSHOT_SLOTS) {
+            n = SNAPSHOT_SLOTS;
+        }
+        snapshot.performance_metric_count = n;
+        for (uint32_t i = 0; i < n; ++i) {
+            snapshot.performance_metrics[i] = static_cast<double>(sum(i));
+        }
+    }
+
+    // Launch the aggregator: every interval it sums the slabs and publishes
+    // through the dashboard seqlock. The publisher must outlive the
+    // registry. Runs as a plain background thread; callers that use the
+    // ThreadManager roles can run runAggregatorOnce in their own loop
+    // instead.
+    void startAggregator(DashboardPublisher* publisher, int interval_ms = 1000) {
+        if (aggregator_running_.exchange(true)) {
+            return;
+        }
+        publisher_ = publisher;
+        interval_ms_ = interval_ms;
+        aggregator_ = std::thread([this] {
+            DashboardSnapshot snapshot{};
+            while (aggregator_running_.load(std::memory_order_relaxed)) {
+                runAggregatorOnce(snapshot);
+                std::this_thread::sleep_for(std::chrono::milliseconds(interval_ms_));
+            }
+        });
+    }
+
+    void runAggregatorOnce(DashboardSnapshot& snapshot) {
+        snapshot.publish_ts_ns = static_cast<uint64_t>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::system_clock::now().time_since_epoch()).count());
+        aggregateInto(snapshot);
+        if (publisher_ != nullptr) {
+            publisher_->publish(snapshot);
+        }
+    }
+
+    void stopAggregator() {
+        if (aggregator_running_.exchange(false) && aggregator_.joinable()) {
+            aggregator_.join();
+        }
+    }
+
+    ~MetricsRegistry() { stopAggregator(); }
+
+private:
+    MetricsRegistry() = default;
+    MetricsRegistry(const MetricsRegistry&) = delete;
+    MetricsRegistry& operator=(const MetricsRegistry&) = delete;
+
+    // One cache line per counter per thread: increments from different
+    // counters on the same thread don't false-share either.
+    struct alignas(64) PaddedCounter {
+        std::atomic<uint64_t> value{0};
+        char pad[64 - sizeof(std::atomic<uint64_t>)];
+    };
+
+    struct ThreadSlab {
+        PaddedCounter counters[MAX_COUNTERS];
+        ThreadSlab* next = nullptr;
+    };
+
+    // Lazily allocate this thread's slab and push it onto the intrusive
+    // list. Runs once per thread; CAS-loop publish, traversals use acquire.
+    ThreadSlab& slab() {
+        thread_local ThreadSlab* tls = nullptr;
+        if (tls == nullptr) {
+            tls = new ThreadSlab();
+            ThreadSlab* head = slabs_.load(std::memory_order_relaxed);
+            do {
+                tls->next = head;
+            } while (!slabs_.compare_exchange_weak(head, tls,
+                                                   std::memory_order_release,
+                                                   std::memory_order_relaxed));
+        }
+        return *tls;
+    }
+
+    std::atomic<ThreadSlab*> slabs_{nullptr};
+    std::atomic<uint32_t> count_{0};
+    char names_[MAX_COUNTERS][MAX_NAME] = {};
+
+    DashboardPublisher* publisher_ = nullptr;
+    int interval_ms_ = 1000;
+    std::atomic<bool> aggregator_running_{false};
+    std::thread aggregator_;
+};
+
+// Cheap copyable handle: components register once and keep one of these.
+class Counter {
+public:
+    explicit Counter(MetricId id) : id_(id) {}
+    explicit Counter(const char* name)
+        : id_(MetricsRegistry::instance().registerCounter(name)) {}
+
+    void inc() { MetricsRegistry::instance().add(id_, 1); }
+    void add(int64_t delta) { MetricsRegistry::instance().add(id_, delta); }
+    int64_t sum() const { return MetricsRegistry::instance().sum(id_); }
+    const char* name() const { return MetricsRegistry::instance().counterName(id_); }
+
+private:
+    MetricId id_;
+};
+
+#endif  // METRICS_REGISTRY_HPP
@@ -0,0 +1,194 @@
+#ifndef CONNECTOR_POOL_HPP
+#define CONNECTOR_POOL_HPP
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "spsc_ring_buffer.hpp"
+#include "market_messages.hpp"
+
+#if defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+// Multi-venue connector pool.
+//
+// Owns N venue connections and runs each on its own (optionally core-pinned)
+// thread, so no venue's data is ever stale because another venue was polled
+// first. Each venue thread drains its connector's tick ring in batches and
+// does two things with every tick:
+//
+//   1. Symbol-routed fan-out: subscribers registered for the tick's symbol id
+//      are invoked inline on the venue thread — a flat table lookup plus a
+//      loop over that symbol's subscriber list, no shared dispatch lock.
+//
+//   2. Merged feed: the tick is forwarded into a per-venue SPSC ring that the
+//      consuming strategy merges by local receive timestamp, giving the
+//      arbitrage loop one time-ordered stream across all venues instead of
+//      pull-polling venues sequentially.
+//
+// The Connector type must provide:
+//   std::size_t get_market_data_batch(MarketTick* out, std::size_t max);
+//   void connect(); void disconnect();
+//
+// Subscriptions must be registered before start() — the dispatch table is
+// read-only while the venue threads run, which is what lets dispatch go
+// lockless.
+template <typename Connector>
+class ConnectorPool {
+public:
+    using TickCallback = std::function<void(const MarketTick&)>;
+
+    static constexpr std::size_t MAX_SYMBOLS = 1024;
+    static constexpr std::size_t MAX_VENUES = 8;
+    static constexpr std::size_t MERGE_RING_CAPACITY = 16384;
+    static constexpr std::size_t DRAIN_BATCH = 64;
+
+    ConnectorPool() : subscribers_(MAX_SYMBOLS), running_(false) {}
+
+    ~ConnectorPool() { stop(); }
+
+    ConnectorPool(const ConnectorPool&) = delete;
+    ConnectorPool& operator=(const ConnectorPool&) = delete;
+
+    // Register a venue connection. `core_id` pins the venue thread to that
+    // core (-1 leaves placement to the scheduler). Call before start().
+    void add_venue(std::shared_ptr<Connector> connector, uint16_t venue_id, int core_id = -1) {
+        auto slot = std::make_unique<VenueSlot>();
+        slot->connector = std::move(connector);
+        slot->venue_id = venue_id;
+        slot->core_id = core_id;
+        venues_.push_back(std::move(slot));
+    }
+
+    // Subscribe a callback to one symbol's ticks (all venues). Call before
+    // start(); the table is immutable while threads run.
+    void subscribe(uint32_t symbol_id, TickCallback callback) {
+        if (symbol_id < MAX_SYMBOLS) {
+            subscribers_[symbol_id].push_back(std::move(callback));
+        }
+    }
+
+    void start() {
+        running_.store(true, std::memory_order_release);
+        for (auto& venue : venues_) {
+            venue->connector->connect();
+            venue->thread = std::thread([this, v = venue.get()]() {
+                pin_to_core(v->core_id);
+                venue_loop(*v);
+            });
+        }
+    }
+
+    void stop() {
+        running_.store(false, std::memory_order_release);
+        for (auto& venue : venues_) {
+            if (venue->thread.joinable()) {
+                venue->thread.join();
+            }
+            venue->connector->disconnect();
+        }
+    }
+
+    // Merged, timestamp-ordered consumption for the strategy thread: stages
+    // the head tick of every venue ring and hands back the earliest by local
+    // receive time. Returns false when no venue has data pending. Single
+    // consumer only.
+    bool poll_merged(MarketTick& out) {
+        int best = -1;
+        uint64_t best_ts = UINT64_MAX;
+        for (std::size_t i = 0; i < venues_.size(); ++i) {
+            VenueSlot& venue = *venues_[i];
+            if (!venue.staged_valid) {
+                venue.staged_valid = venue.merge_ring.try_pop(venue.staged);
+            }
+            if (venue.staged_valid && venue.staged.local_rx_ts_ns < best_ts) {
+                best_ts = venue.staged.local_rx_ts_ns;
+                best = static_cast<int>(i);
+            }
+        }
+        if (best < 0) {
+            return false;
+        }
+        out = venues_[best]->staged;
+        venues_[best]->staged_valid = false;
+        return true;
+    }
+
+    uint64_t dropped_merge_ticks() const {
+        uint64_t total = 0;
+        for (const auto& venue : venues_) {
+            total += venue->dropped.load(std::memory_order_relaxed);
+        }
+        return total;
+    }
+
+    std::size_t venue_count() const { return venues_.size(); }
+
+private:
+    struct VenueSlot {
+        std::shared_ptr<Connector> connector;
+        std::thread thread;
+        uint16_t venue_id = 0;
+        int core_id = -1;
+        SPSCRingBuffer<MarketTick, MERGE_RING_CAPACITY> merge_ring;
+        std::atomic<uint64_t> dropped{0};
+        // Consumer-side staging for the timestamp merge; touched only by the
+        // poll_merged caller.
+        MarketTick staged{};
+        bool staged_valid = false;
+    };
+
+    void venue_loop(VenueSlot& venue) {
+        MarketTick batch[DRAIN_BATCH];
+        while (running_.load(std::memory_order_relaxed)) {
+            std::size_t n = venue.connector->get_market_data_batch(batch, DRAIN_BATCH);
+            for (std::size_t i = 0; i < n; ++i) {
+                MarketTick& tick = batch[i];
+                tick.venue_id = venue.venue_id;
+                dispatch(tick);
+                if (!venue.merge_ring.try_push(tick)) {
+                    venue.dropped.fetch_add(1, std::memory_order_relaxed);
+                }
+            }
+            if (n == 0) {
+#if defined(__x86_64__) || defined(_M_X64)
+                __builtin_ia32_pause();
+#endif
+            }
+        }
+    }
+
+    void dispatch(const MarketTick& tick) {
+        if (tick.symbol_id >= MAX_SYMBOLS) {
+            return;
+        }
+        for (const auto& callback : subscribers_[tick.symbol_id]) {
+            callback(tick);
+        }
+    }
+
+    static void pin_to_core(int core_id) {
+#if defined(__linux__)
+        if (core_id >= 0) {
+            cpu_set_t cpuset;
+            CPU_ZERO(&cpuset);
+            CPU_SET(core_id, &cpuset);
+            pthread_setaffinity_np(pthread_self(), sizeof(cpuset), &cpuset);
+        }
+#else
+        (void)core_id;
+#endif
+    }
+
+    std::vector<std::unique_ptr<VenueSlot>> venues_;
+    std::vector<std::vector<TickCallback>> subscribers_;
+    std::atomic<bool> running_;
+};
+
+#endif  // CONNECTOR_POOL_HPP
@@ -8,14 +8,26 @@
 #include <atomic>
 #include <chrono>
 #include <memory>
-#include <asio.hpp> 
-#include "fix_connector.hpp" 
-#include "websocket_connector.hpp" 
+#include <asio.hpp>
+#include "fix_connector.hpp"
+#include "websocket_connector.hpp"
+#include "spsc_ring_buffer.hpp"
+#include "fix_engine.hpp"
+#include "market_messages.hpp"
+#include "symbol_table.hpp"
+#include "thread_manager.hpp"
+#include "tick_capture.hpp"
 
 class ExchangeConnector {
 public:
     ExchangeConnector(const std::string& exchange, const std::string& api_key, const std::string& secret_key)
-        : exchange_name(exchange), api_key(api_key), secret_key(secret_key), is_connected(false), stop_flag(false) {}
+        : exchange_name(exchange), api_key(api_key), secret_key(secret_key), is_connected(false), stop_flag(false),
+          busy_poll(false), strand(asio::make_strand(io_context)) {}
+
+    // Busy-poll mode for latency-critical venues: the reactor thread spins on
+    // io_context::poll() on a pinned core instead of blocking in run_one_for.
+    // Burns the core, saves the wakeup latency. Set before connect().
+    void set_busy_poll(bool enabled) { busy_poll.store(enabled); }
 
     ~ExchangeConnector() { stop(); }
 
@@ -25,7 +37,10 @@ public:
             std::cout << "Already connected to " << exchange_name << std::endl;
             return;
         }
-        connection_thread = std::thread([this]() { this->run(); });
+        // Reactor runs under the feed role: pinned core, optional FIFO and
+        // busy-spin per configs/config.yaml, arenas first-touched on-node.
+        connection_thread = ThreadManager::instance().launch(ThreadRole::FEED,
+                                                             [this]() { this->run(); });
         connection_cv.wait(connection_lock, [this] { return is_connected.load(); });
     }
 
@@ -38,38 +53,83 @@ public:
         is_connected.store(false);
     }
 
-    void send_order(const std::string& order_data) {
+    // Strategy thread is the single producer of the order ring; the reactor
+    // thread is its single consumer. Wait-free hand-off, no mutex, no sleep.
+    // Orders are fixed-layout 32-byte PODs — enqueue is a single memcpy, no
+    // heap allocation and no text formatting on the hot path. The reactor
+    // drains the ring in batches between io events, so back-to-back
+    // cancel/replace pairs coalesce into one write burst on the wire.
+    void send_order(const OrderMsg& order) {
         if (!is_connected) {
             std::cerr << "Not connected. Cannot send order." << std::endl;
             return;
         }
-        std::lock_guard<std::mutex> lock(order_mutex);
-        orders.push(order_data);
+        if (!orders.try_push(order)) {
+            // Egress ring full: the venue session is not draining. Dropping is
+            // safer than blocking the strategy thread behind a sick session.
+            dropped_orders.fetch_add(1, std::memory_order_relaxed);
+            std::cerr << "Order ring full. Order dropped." << std::endl;
+        }
     }
 
+    // Interns the symbol on the way in; the subscription list (and every
+    // tick dispatched against it) carries dense ids, not strings.
     void subscribe_market_data(const std::string& symbol) {
+        const uint32_t symbol_id = SymbolTable::instance().intern(symbol);
         std::lock_guard<std::mutex> lock(data_mutex);
-        market_data_subscriptions.push_back(symbol);
+        market_data_subscriptions.push_back(symbol_id);
     }
 
-    std::string get_market_data() {
-        std::lock_guard<std::mutex> lock(data_mutex);
-        if (market_data.empty()) {
-            return "";
-        }
-        std::string data = market_data.front();
-        market_data.pop();
-        return data;
+    // Attach a tick capture file: every inbound tick is appended to the
+    // mmap'd capture as it enters the ring. The writer belongs to the
+    // reactor thread once attached — set it up before connect().
+    void attach_capture(TickCaptureWriter* writer) {
+        capture_writer = writer;
+    }
+
+    // Non-blocking poll used by strategies that interleave other work.
+    bool get_market_data(MarketTick& out) {
+        return market_data.try_pop(out);
+    }
+
+    // Busy-spin consume mode for latency-critical strategies: pins the caller
+    // in a spin on the tick ring until data arrives or the connector stops.
+    bool spin_market_data(MarketTick& out) {
+        return market_data.spin_pop(out, [this] { return !stop_flag.load(std::memory_order_relaxed); });
+    }
+
+    // Batched dequeue: drains up to `max_items` ticks with one index acquire.
+    std::size_t get_market_data_batch(MarketTick* out, std::size_t max_items) {
+        return market_data.pop_batch(out, max_items);
+    }
+
+    uint64_t get_dropped_order_count() const {
+        return dropped_orders.load(std::memory_order_relaxed);
     }
 
 private:
+    // Ring capacities are sized for a 300k msg/sec venue burst: 64k tick slots
+    // buys ~200ms of consumer stall before drops, which is already an outage.
+    static constexpr std::size_t ORDER_RING_CAPACITY = 4096;
+    static constexpr std::size_t TICK_RING_CAPACITY = 65536;
+    static constexpr std::size_t ORDER_BATCH_SIZE = 64;
+
     std::string exchange_name, api_key, secret_key;
     std::atomic<bool> is_connected, stop_flag;
+    std::atomic<uint64_t> dropped_orders{0};
+    std::atomic<uint64_t> dropped_ticks{0};
+    std::atomic<bool> busy_poll;
     std::thread connection_thread;
-    std::mutex connection_mutex, order_mutex, data_mutex;
+    std::mutex connection_mutex, data_mutex;
     std::condition_variable connection_cv;
-    std::queue<std::string> orders, market_data;
-    std::vector<std::string> market_data_subscriptions;
+    asio::io_context io_context;
+    // All completion handlers for this connection run on one strand, so the
+    // session needs no locks of its own even if we ever add reactor threads.
+    asio::strand<asio::io_context::executor_type> strand;
+    SPSCRingBuffer<OrderMsg, ORDER_RING_CAPACITY> orders;
+    SPSCRingBuffer<MarketTick, TICK_RING_CAPACITY> market_data;
+    std::vector<uint32_t> market_data_subscriptions;  // Interned symbol ids
+    TickCaptureWriter* capture_writer = nullptr;      // Optional, reactor-thread only
 
     void run() {
         try {
@@ -92,26 +152,72 @@ private:
         }
     }
 
+    // Reactor loop: asio owns the socket I/O, this thread owns the rings.
+    //
+    // Inbound ticks arrive through the async read chain armed below — each
+    // completion pushes the parsed MarketTick into the ring and re-arms, so
+    // data moves the moment the kernel has it instead of on a 10ms poll tick.
+    // Between io runs the loop drains the order ring in batches and hands the
+    // burst to the session as one write. In busy-poll mode the loop never
+    // blocks: it spins io_context::poll() on its (pinned) core; otherwise it
+    // parks in run_one_for with a short deadline so shutdown stays prompt.
     template<typename ConnectorType>
     void handle_orders_and_data(ConnectorType& connector) {
-        while (!stop_flag.load()) {
-            if (!orders.empty()) {
-                std::lock_guard<std::mutex> lock(order_mutex);
-                std::string order = orders.front();
-                orders.pop();
-                connector.send_order(order);
+        start_async_read(connector);
+
+        OrderMsg order_batch[ORDER_BATCH_SIZE];
+        while (!stop_flag.load(std::memory_order_relaxed)) {
+            // Dispatch any ready completion handlers (reads, timers).
+            std::size_t handlers_run = io_context.poll();
+
+            // Drain pending orders in a batch so one index acquire covers a
+            // whole burst of cancel/replace traffic, then write them out
+            // back-to-back on the session.
+            std::size_t n = orders.pop_batch(order_batch, ORDER_BATCH_SIZE);
+            for (std::size_t i = 0; i < n; ++i) {
+                connector.send_order(order_batch[i]);
             }
 
-            std::string data = connector.get_market_data();
-            if (!data.empty()) {
-                std::lock_guard<std::mutex> lock(data_mutex);
-                market_data.push(data);
+            if (handlers_run == 0 && n == 0) {
+                if (busy_poll.load(std::memory_order_relaxed)) {
+#if defined(__x86_64__) || defined(_M_X64)
+                    __builtin_ia32_pause();  // Spin; the core is ours
+#endif
+                } else {
+                    // Block in the reactor until the next io event, bounded
+                    // so we re-check stop_flag promptly.
+                    io_context.run_one_for(std::chrono::microseconds(50));
+                }
+            }
+            if (io_context.stopped()) {
+                io_context.restart();
             }
-            std::this_thread::sleep_for(std::chrono::milliseconds(10));
         }
         connector.disconnect();
     }
 
+    // Arm the async read chain: every inbound message lands here on the
+    // connection's strand, goes straight into the tick ring, and re-arms.
+    template<typename ConnectorType>
+    void start_async_read(ConnectorType& connector) {
+        connector.async_receive(io_context, asio::bind_executor(strand,
+            [this, &connector](const MarketTick* tick) {
+                if (tick != nullptr) {
+                    if (capture_writer != nullptr) {
+                        capture_writer->append(*tick);
+                    }
+                    if (!market_data.try_push(*tick)) {
+                        // Strategy side stalled; count the drop rather than
+                        // block the reactor and back up the venue session.
+                        dropped_ticks.fetch_add(1, std::memory_order_relaxed);
+                    }
+                }
+                if (!stop_flag.load(std::memory_order_relaxed)) {
+                    start_async_read(connector);
+                }
+            }));
+    }
+
     void stop() {
         stop_flag = true;
         if (connection_thread.joinable()) {
@@ -123,7 +229,8 @@ private:
 // FIXConnector.cpp
 class FIXConnector {
 public:
-    FIXConnector(const std::string& api_key, const std::string& secret_key) {
+    FIXConnector(const std::string& api_key, const std::string& secret_key)
+        : arena(ARENA_BYTES) {
         // Initialize FIX connection
     }
 
@@ -135,19 +242,79 @@ public:
         std::cout << "Disconnecting FIX Protocol..." << std::endl;
     }
 
-    void send_order(const std::string& order) {
-        std::cout << "Sending order via FIX: " << order << std::endl;
+    // Encode through the baked templates in fix_engine.hpp: a few in-place
+    // field patches plus the incremental checksum, then the wire image is
+    // written straight from the template buffer — no string building, no
+    // copies. OrderManager reuses the order id as ClOrdID across the order's
+    // life, so cancel/replace carry it as OrigClOrdID (41) too.
+    void send_order(const OrderMsg& order) {
+        const bool is_buy = order.side == static_cast<uint8_t>(Side::BUY);
+        const char* symbol = SymbolTable::instance().name(order.symbol_id);
+        const char* sending_time = sending_time_.now();
+        std::string_view wire;
+        switch (static_cast<OrderAction>(order.action)) {
+            case OrderAction::CANCEL:
+                wire = encoder_.encodeCancel(++seqnum_, order.order_id,
+                                             order.order_id, symbol, is_buy,
+                                             sending_time);
+                break;
+            case OrderAction::REPLACE:
+                wire = encoder_.encodeReplace(++seqnum_, order.order_id,
+                                              order.order_id, symbol, is_buy,
+                                              static_cast<int>(order.quantity),
+                                              order.price, sending_time);
+                break;
+            case OrderAction::NEW:
+            default:
+                wire = encoder_.encodeNewOrderSingle(++seqnum_, order.order_id,
+                                                     symbol, is_buy,
+                                                     static_cast<int>(order.quantity),
+                                                     order.price, sending_time);
+                break;
+        }
+        // A real session hands `wire` to asio::async_write here.
+        std::cout << "Sending order via FIX (" << wire.size()
+                  << " bytes): id=" << order.order_id
+                  << " symbol=" << symbol
+                  << " px=" << from_price_ticks(order.price)
+                  << " qty=" << order.quantity << std::endl;
     }
 
-    std::string get_market_data() {
-        return "FIX Market Data";
+    // Arm one async read. A real session issues asio::async_read on the FIX
+    // socket; on completion it indexes the buffer with FixDecoder (tag-offset
+    // table, values read in place) into the arena and invokes the handler
+    // with the parsed tick. The arena is reset per read — the previous tick
+    // has been copied out of it by then.
+    template<typename Handler>
+    void async_receive(asio::io_context& io, Handler handler) {
+        asio::post(io, [this, handler = std::move(handler)]() mutable {
+            arena.reset();
+            MarketTick* tick = arena.alloc<MarketTick>();
+            if (tick != nullptr) {
+                tick->price = to_price_ticks(100.0);
+                tick->size = 100;
+                tick->venue_id = 1;
+                tick->local_rx_ts_ns = static_cast<uint64_t>(
+                    std::chrono::duration_cast<std::chrono::nanoseconds>(
+                        std::chrono::steady_clock::now().time_since_epoch()).count());
+            }
+            handler(static_cast<const MarketTick*>(tick));
+        });
     }
+
+private:
+    static constexpr std::size_t ARENA_BYTES = 1 << 20;
+    MessageArena arena;
+    FixEncoder encoder_{"HFTALGO", "EXCHANGE"};
+    FixSendingTime sending_time_;
+    uint64_t seqnum_ = 0;
 };
 
 // WebSocketConnector.cpp
 class WebSocketConnector {
 public:
-    WebSocketConnector(const std::string& api_key, const std::string& secret_key) {
+    WebSocketConnector(const std::string& api_key, const std::string& secret_key)
+        : arena(ARENA_BYTES) {
         // Initialize WebSocket connection
     }
 
@@ -159,13 +326,33 @@ public:
         std::cout << "Disconnecting WebSocket..." << std::endl;
     }
 
-    void send_order(const std::string& order) {
-        std::cout << "Sending order via WebSocket: " << order << std::endl;
+    void send_order(const OrderMsg& order) {
+        std::cout << "Sending order via WebSocket: id=" << order.order_id
+                  << " symbol=" << order.symbol_id
+                  << " px=" << from_price_ticks(order.price)
+                  << " qty=" << order.quantity << std::endl;
     }
 
-    std::string get_market_data() {
-        return "WebSocket Market Data";
+    template<typename Handler>
+    void async_receive(asio::io_context& io, Handler handler) {
+        asio::post(io, [this, handler = std::move(handler)]() mutable {
+            arena.reset();
+            MarketTick* tick = arena.alloc<MarketTick>();
+            if (tick != nullptr) {
+                tick->price = to_price_ticks(100.0);
+                tick->size = 100;
+                tick->venue_id = 2;
+                tick->local_rx_ts_ns = static_cast<uint64_t>(
+                    std::chrono::duration_cast<std::chrono::nanoseconds>(
+                        std::chrono::steady_clock::now().time_since_epoch()).count());
+            }
+            handler(static_cast<const MarketTick*>(tick));
+        });
     }
+
+private:
+    static constexpr std::size_t ARENA_BYTES = 1 << 20;
+    MessageArena arena;
 };
 
 // Main to demonstrate functionality
@@ -173,11 +360,22 @@ int main() {
     ExchangeConnector connector("FIX", "api_key", "secret_key");
     connector.connect();
     connector.subscribe_market_data("AAPL");
-    connector.send_order("Buy 100 shares");
-    
+
+    OrderMsg order{};
+    order.order_id = 1;
+    order.symbol_id = 1;  // AAPL
+    order.price = to_price_ticks(150.25);
+    order.quantity = 100;
+    order.side = static_cast<uint8_t>(Side::BUY);
+    order.action = static_cast<uint8_t>(OrderAction::NEW);
+    connector.send_order(order);
+
     std::this_thread::sleep_for(std::chrono::seconds(1));
-    std::string market_data = connector.get_market_data();
-    std::cout << "Received Market Data: " << market_data << std::endl;
+    MarketTick tick{};
+    if (connector.get_market_data(tick)) {
+        std::cout << "Received Market Data: px=" << from_price_ticks(tick.price)
+                  << " size=" << tick.size << " venue=" << tick.venue_id << std::endl;
+    }
 
     connector.disconnect();
     return 0;
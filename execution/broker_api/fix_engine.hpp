@@ -0,0 +1,486 @@
+#ifndef FIX_ENGINE_HPP
+#define FIX_ENGINE_HPP
+
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <ctime>
+#include <string>
+#include <string_view>
+
+// Zero-copy FIX encode/decode.
+//
+// Building FIX strings with stream concatenation costs a few microseconds
+// and several allocations per order — it would dominate the send path. This
+// engine instead bakes each message type's skeleton once at session start:
+// every constant field (BeginString, MsgType, comp ids, constant body
+// length, delimiters) is laid into a static buffer, and every per-order
+// field (ClOrdID, seqnum, qty, price, side, symbol, sending time) is a
+// fixed-width slot at a known offset. Encoding a message is then a handful
+// of in-place integer-to-ASCII patches plus a checksum over just the
+// patched slots — the constant region's byte sum is precomputed — and the
+// result is written to the socket straight from the template buffer. No
+// intermediate string, no allocation, no copies.
+//
+// Numeric slots are zero-padded to fixed width (ClOrdID 10, seqnum 8,
+// qty 8, price 8.4) and the symbol slot is space-padded to 8, which keeps
+// every offset — and therefore BodyLength — constant per template. Venue
+// profiles that reject padded values get a per-venue template with the
+// widths they specify; the mechanism does not change.
+//
+// Decoding is tag-offset indexing, not generic parsing: one pass over the
+// buffer records each tag's value offset and length in a flat table, and
+// field accessors return string_views into the original buffer.
+
+constexpr char FIX_SOH = '\x01';
+
+// One variable field slot inside a baked template.
+struct FixSlot {
+    int tag = 0;
+    int offset = 0;   // First byte of the value in the buffer
+    int width = 0;    // Fixed value width in bytes
+};
+
+class FixMessageTemplate {
+public:
+    static constexpr int MAX_BYTES = 512;
+    static constexpr int MAX_SLOTS = 16;
+
+    // ---- Baking (session start, cold) -----------------------------------
+
+    // Append a constant field: "tag=value<SOH>".
+    void addConst(int tag, std::string_view value) {
+        appendInt(tag);
+        append('=');
+        for (char ch : value) {
+            append(ch);
+        }
+        append(FIX_SOH);
+    }
+
+    // Append a variable field slot of fixed width, initially zero-filled
+    // (space-filled for text slots). Returns the slot index for patching.
+    int addSlot(int tag, int width, char fill = '0') {
+        appendInt(tag);
+        append('=');
+        FixSlot& slot = slots_[slot_count_];
+        slot.tag = tag;
+        slot.offset = size_;
+        slot.width = width;
+        for (int i = 0; i < width; ++i) {
+            append(fill);
+        }
+        append(FIX_SOH);
+        return slot_count_++;
+    }
+
+    // Finish the skeleton: back-patch BodyLength (everything after the 9=
+    // field, which is why it must be baked with a fixed width), append the
+    // checksum trailer slot, and precompute the constant-region byte sum.
+    //
+    // body_length_slot is the slot returned for tag 9.
+    void seal(int body_length_slot) {
+        const int body_start = slots_[body_length_slot].offset +
+                               slots_[body_length_slot].width + 1;
+        patchUInt(body_length_slot, static_cast<uint64_t>(size_ - body_start));
+        // Trailer: "10=XXX<SOH>". The checksum covers every byte before it.
+        checksum_covered_ = size_;
+        checksum_slot_ = addSlot(10, 3);
+        // Sum of all covered bytes as baked; finalize() adjusts for patches
+        // by re-summing only the variable slots.
+        baked_sum_ = 0;
+        for (int i = 0; i < checksum_covered_; ++i) {
+            baked_sum_ += static_cast<unsigned char>(buffer_[i]);
+        }
+        for (int s = 0; s < slot_count_; ++s) {
+            if (s == checksum_slot_) {
+                continue;
+            }
+            for (int i = 0; i < slots_[s].width; ++i) {
+                baked_sum_ -= static_cast<unsigned char>(buffer_[slots_[s].offset + i]);
+            }
+        }
+    }
+
+    // ---- Encoding (hot) -------------------------------------------------
+
+    // Right-aligned zero-padded unsigned integer.
+    void patchUInt(int slot_index, uint64_t value) {
+        const FixSlot& slot = slots_[slot_index];
+        char* p = buffer_ + slot.offset;
+        for (int i = slot.width - 1; i >= 0; --i) {
+            p[i] = static_cast<char>('0' + value % 10);
+            value /= 10;
+        }
+    }
+
+    // Fixed-point price in ticks (1/10000), rendered as width-4 dot 4.
+    void patchPriceTicks(int slot_index, int64_t price_ticks) {
+        const FixSlot& slot = slots_[slot_index];
+        char* p = buffer_ + slot.offset;
+        uint64_t whole = static_cast<uint64_t>(price_ticks / 10000);
+        uint64_t frac = static_cast<uint64_t>(price_ticks % 10000);
+        p[slot.width - 5] = '.';
+        for (int i = slot.width - 1; i >= slot.width - 4; --i) {
+            p[i] = static_cast<char>('0' + frac % 10);
+            frac /= 10;
+        }
+        for (int i = slot.width - 6; i >= 0; --i) {
+            p[i] = static_cast<char>('0' + whole % 10);
+            whole /= 10;
+        }
+    }
+
+    void patchChar(int slot_index, char value) {
+        buffer_[slots_[slot_index].offset] = value;
+    }
+
+    // Left-aligned, space-padded text (symbol, time strings).
+    void patchText(int slot_index, const char* value) {
+        const FixSlot& slot = slots_[slot_index];
+        char* p = buffer_ + slot.offset;
+        int i = 0;
+        while (i < slot.width && value[i] != '\0') {
+            p[i] = value[i];
+            ++i;
+        }
+        while (i < slot.width) {
+            p[i++] = ' ';
+        }
+    }
+
+    // Recompute the checksum from the precomputed constant sum plus the
+    // current variable-slot bytes, patch the trailer, and expose the wire
+    // image. The returned view aliases the template buffer — write it
+    // before the next encode on this template.
+    std::string_view finalize() {
+        unsigned sum = baked_sum_;
+        for (int s = 0; s < slot_count_; ++s) {
+            if (s == checksum_slot_) {
+                continue;
+            }
+            const FixSlot& slot = slots_[s];
+            for (int i = 0; i < slot.width; ++i) {
+                sum += static_cast<unsigned char>(buffer_[slot.offset + i]);
+            }
+        }
+        patchUInt(checksum_slot_, sum % 256);
+        return std::string_view(buffer_, static_cast<std::size_t>(size_));
+    }
+
+    const char* data() const { return buffer_; }
+    int size() const { return size_; }
+
+private:
+    void append(char ch) {
+        if (size_ < MAX_BYTES) {
+            buffer_[size_++] = ch;
+        }
+    }
+
+    void appendInt(int value) {
+        char digits[12];
+        int n = 0;
+        do {
+            digits[n++] = static_cast<char>('0' + value % 10);
+            value /= 10;
+        } while (value > 0);
+        while (n > 0) {
+            append(digits[--n]);
+        }
+    }
+
+    char buffer_[MAX_BYTES] = {};
+    int size_ = 0;
+    FixSlot slots_[MAX_SLOTS];
+    int slot_count_ = 0;
+    int checksum_slot_ = -1;
+    int checksum_covered_ = 0;
+    unsigned baked_sum_ = 0;
+};
+
+// Session-level encoder: owns one baked template per outgoing message type
+// and the slot indexes for their hot fields.
+class FixEncoder {
+public:
+    FixEncoder(std::string_view sender_comp_id, std::string_view target_comp_id) {
+        bakeNewOrderSingle(sender_comp_id, target_comp_id);
+        bakeCancel(sender_comp_id, target_comp_id);
+        bakeReplace(sender_comp_id, target_comp_id);
+    }
+
+    // NewOrderSingle (35=D). Returns the wire image; valid until the next
+    // encode on this encoder.
+    std::string_view encodeNewOrderSingle(uint64_t seqnum, uint64_t cl_ord_id,
+                                          const char* symbol, bool is_buy,
+                                          int quantity, int64_t price_ticks,
+                                          const char* sending_time_utc) {
+        new_order_.patchUInt(nos_seq_, seqnum);
+        new_order_.patchText(nos_time_, sending_time_utc);
+        new_order_.patchUInt(nos_clordid_, cl_ord_id);
+        new_order_.patchText(nos_symbol_, symbol);
+        new_order_.patchChar(nos_side_, is_buy ? '1' : '2');
+        new_order_.patchUInt(nos_qty_, static_cast<uint64_t>(quantity));
+        new_order_.patchPriceTicks(nos_price_, price_ticks);
+        return new_order_.finalize();
+    }
+
+    // OrderCancelRequest (35=F).
+    std::string_view encodeCancel(uint64_t seqnum, uint64_t cl_ord_id,
+                                  uint64_t orig_cl_ord_id, const char* symbol,
+                                  bool is_buy, const char* sending_time_utc) {
+        cancel_.patchUInt(cxl_seq_, seqnum);
+        cancel_.patchText(cxl_time_, sending_time_utc);
+        cancel_.patchUInt(cxl_clordid_, cl_ord_id);
+        cancel_.patchUInt(cxl_orig_, orig_cl_ord_id);
+        cancel_.patchText(cxl_symbol_, symbol);
+        cancel_.patchChar(cxl_side_, is_buy ? '1' : '2');
+        return cancel_.finalize();
+    }
+
+    // OrderCancelReplaceRequest (35=G).
+    std::string_view encodeReplace(uint64_t seqnum, uint64_t cl_ord_id,
+                                   uint64_t orig_cl_ord_id, const char* symbol,
+                                   bool is_buy, int quantity, int64_t price_ticks,
+                                   const char* sending_time_utc) {
+        replace_.patchUInt(rpl_seq_, seqnum);
+        replace_.patchText(rpl_time_, sending_time_utc);
+        replace_.patchUInt(rpl_clordid_, cl_ord_id);
+        replace_.patchUInt(rpl_orig_, orig_cl_ord_id);
+        replace_.patchText(rpl_symbol_, symbol);
+        replace_.patchChar(rpl_side_, is_buy ? '1' : '2');
+        replace_.patchUInt(rpl_qty_, static_cast<uint64_t>(quantity));
+        replace_.patchPriceTicks(rpl_price_, price_ticks);
+        return replace_.finalize();
+    }
+
+private:
+    // Slot widths: constant offsets are the whole point, so every variable
+    // field has a fixed width (see the file comment).
+    static constexpr int W_SEQ = 8;
+    static constexpr int W_TIME = 21;      // YYYYMMDD-HH:MM:SS.mmm
+    static constexpr int W_CLORDID = 10;
+    static constexpr int W_SYMBOL = 8;
+    static constexpr int W_QTY = 8;
+    static constexpr int W_PRICE = 13;     // 8 digits '.' 4 digits
+    static constexpr int W_BODYLEN = 4;
+
+    void bakeHeader(FixMessageTemplate& msg, std::string_view msg_type,
+                    std::string_view sender, std::string_view target,
+                    int& body_len_slot, int& seq_slot, int& time_slot) {
+        msg.addConst(8, "FIX.4.4");
+        body_len_slot = msg.addSlot(9, W_BODYLEN);
+        msg.addConst(35, msg_type);
+        msg.addConst(49, sender);
+        msg.addConst(56, target);
+        seq_slot = msg.addSlot(34, W_SEQ);
+        time_slot = msg.addSlot(52, W_TIME, ' ');
+    }
+
+    void bakeNewOrderSingle(std::string_view sender, std::string_view target) {
+        int body_len;
+        bakeHeader(new_order_, "D", sender, target, body_len, nos_seq_, nos_time_);
+        nos_clordid_ = new_order_.addSlot(11, W_CLORDID);
+        nos_symbol_ = new_order_.addSlot(55, W_SYMBOL, ' ');
+        nos_side_ = new_order_.addSlot(54, 1);
+        nos_qty_ = new_order_.addSlot(38, W_QTY);
+        new_order_.addConst(40, "2");  // Limit
+        nos_price_ = new_order_.addSlot(44, W_PRICE);
+        new_order_.addConst(59, "0");  // Day
+        new_order_.seal(body_len);
+    }
+
+    void bakeCancel(std::string_view sender, std::string_view target) {
+        int body_len;
+        bakeHeader(cancel_, "F", sender, target, body_len, cxl_seq_, cxl_time_);
+        cxl_clordid_ = cancel_.addSlot(11, W_CLORDID);
+        cxl_orig_ = cancel_.addSlot(41, W_CLORDID);
+        cxl_symbol_ = cancel_.addSlot(55, W_SYMBOL, ' ');
+        cxl_side_ = cancel_.addSlot(54, 1);
+        cancel_.seal(body_len);
+    }
+
+    void bakeReplace(std::string_view sender, std::string_view target) {
+        int body_len;
+        bakeHeader(replace_, "G", sender, target, body_len, rpl_seq_, rpl_time_);
+        rpl_clordid_ = replace_.addSlot(11, W_CLORDID);
+        rpl_orig_ = replace_.addSlot(41, W_CLORDID);
+        rpl_symbol_ = replace_.addSlot(55, W_SYMBOL, ' ');
+        rpl_side_ = replace_.addSlot(54, 1);
+        rpl_qty_ = replace_.addSlot(38, W_QTY);
+        replace_.addConst(40, "2");
+        rpl_price_ = replace_.addSlot(44, W_PRICE);
+        replace_.seal(body_len);
+    }
+
+    FixMessageTemplate new_order_;
+    int nos_seq_ = -1, nos_time_ = -1, nos_clordid_ = -1, nos_symbol_ = -1;
+    int nos_side_ = -1, nos_qty_ = -1, nos_price_ = -1;
+
+    FixMessageTemplate cancel_;
+    int cxl_seq_ = -1, cxl_time_ = -1, cxl_clordid_ = -1, cxl_orig_ = -1;
+    int cxl_symbol_ = -1, cxl_side_ = -1;
+
+    FixMessageTemplate replace_;
+    int rpl_seq_ = -1, rpl_time_ = -1, rpl_clordid_ = -1, rpl_orig_ = -1;
+    int rpl_symbol_ = -1, rpl_side_ = -1, rpl_qty_ = -1, rpl_price_ = -1;
+};
+
+// SendingTime (52) formatter: "YYYYMMDD-HH:MM:SS.mmm". gmtime plus eight
+// digit writes per message would be the slowest part of an encode, so the
+// date/time prefix is cached and rebuilt only when the second rolls over;
+// within a second only the millisecond digits are patched.
+class FixSendingTime {
+public:
+    // Returns a pointer to the 21-byte formatted time, valid until the
+    // next call on this instance.
+    const char* now() {
+        const auto tp = std::chrono::system_clock::now();
+        const std::time_t sec = std::chrono::system_clock::to_time_t(tp);
+        if (sec != cached_sec_) {
+            cached_sec_ = sec;
+            std::tm utc{};
+            gmtime_r(&sec, &utc);
+            writeDigits(buf_, static_cast<unsigned>(utc.tm_year + 1900), 4);
+            writeDigits(buf_ + 4, static_cast<unsigned>(utc.tm_mon + 1), 2);
+            writeDigits(buf_ + 6, static_cast<unsigned>(utc.tm_mday), 2);
+            buf_[8] = '-';
+            writeDigits(buf_ + 9, static_cast<unsigned>(utc.tm_hour), 2);
+            buf_[11] = ':';
+            writeDigits(buf_ + 12, static_cast<unsigned>(utc.tm_min), 2);
+            buf_[14] = ':';
+            writeDigits(buf_ + 15, static_cast<unsigned>(utc.tm_sec), 2);
+            buf_[17] = '.';
+        }
+        const auto since_epoch = tp.time_since_epoch();
+        const unsigned millis = static_cast<unsigned>(
+            std::chrono::duration_cast<std::chrono::milliseconds>(since_epoch).count() % 1000);
+        writeDigits(buf_ + 18, millis, 3);
+        return buf_;
+    }
+
+private:
+    static void writeDigits(char* p, unsigned value, int width) {
+        for (int i = width - 1; i >= 0; --i) {
+            p[i] = static_cast<char>('0' + value % 10);
+            value /= 10;
+        }
+    }
+
+    char buf_[22] = {};
+    std::time_t cached_sec_ = -1;
+};
+
+// Tag-offset decoder. index() makes one pass over the buffer recording
+// where each tag's value starts and ends; accessors are O(1) table reads
+// returning views into the original bytes — nothing is copied or converted
+// until the caller asks for a specific field.
+class FixDecoder {
+public:
+    static constexpr int MAX_TAG = 1024;
+
+    // Index a complete FIX message. Returns false on a malformed buffer or
+    // checksum mismatch (pass verify_checksum = false for pre-validated
+    // input off the session layer).
+    bool index(const char* data, std::size_t len, bool verify_checksum = true) {
+        data_ = data;
+        std::memset(value_len_, 0, sizeof(value_len_));
+        std::size_t i = 0;
+        std::size_t checksum_field_start = 0;
+        while (i < len) {
+            int tag = 0;
+            const std::size_t field_start = i;
+            while (i < len && data[i] != '=') {
+                if (data[i] < '0' || data[i] > '9') {
+                    return false;
+                }
+                tag = tag * 10 + (data[i] - '0');
+                ++i;
+            }
+            if (i >= len) {
+                return false;
+            }
+            ++i;  // '='
+            const std::size_t value_start = i;
+            while (i < len && data[i] != FIX_SOH) {
+                ++i;
+            }
+            if (i >= len) {
+                return false;  // Unterminated field
+            }
+            if (tag > 0 && tag < MAX_TAG) {
+                value_off_[tag] = static_cast<uint32_t>(value_start);
+                value_len_[tag] = static_cast<uint32_t>(i - value_start);
+            }
+            if (tag == 10) {
+                checksum_field_start = field_start;
+            }
+            ++i;  // SOH
+        }
+        if (verify_checksum) {
+            if (value_len_[10] != 3 || checksum_field_start == 0) {
+                return false;
+            }
+            unsigned sum = 0;
+            for (std::size_t b = 0; b < checksum_field_start; ++b) {
+                sum += static_cast<unsigned char>(data[b]);
+            }
+            if (static_cast<int>(sum % 256) != static_cast<int>(getUInt(10))) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    bool has(int tag) const { return tag > 0 && tag < MAX_TAG && value_len_[tag] != 0; }
+
+    std::string_view get(int tag) const {
+        if (!has(tag)) {
+            return {};
+        }
+        return std::string_view(data_ + value_off_[tag], value_len_[tag]);
+    }
+
+    uint64_t getUInt(int tag) const {
+        uint64_t value = 0;
+        for (char ch : get(tag)) {
+            if (ch < '0' || ch > '9') {
+                break;
+            }
+            value = value * 10 + static_cast<uint64_t>(ch - '0');
+        }
+        return value;
+    }
+
+    // Fixed-point price in ticks (1/10000) from a decimal field.
+    int64_t getPriceTicks(int tag) const {
+        const std::string_view text = get(tag);
+        int64_t whole = 0;
+        int64_t frac = 0;
+        int frac_digits = 0;
+        std::size_t i = 0;
+        for (; i < text.size() && text[i] != '.'; ++i) {
+            if (text[i] >= '0' && text[i] <= '9') {
+                whole = whole * 10 + (text[i] - '0');
+            }
+        }
+        for (++i; i < text.size() && frac_digits < 4; ++i) {
+            if (text[i] >= '0' && text[i] <= '9') {
+                frac = frac * 10 + (text[i] - '0');
+                ++frac_digits;
+            }
+        }
+        while (frac_digits < 4) {
+            frac *= 10;
+            ++frac_digits;
+        }
+        return whole * 10000 + frac;
+    }
+
+private:
+    const char* data_ = nullptr;
+    uint32_t value_off_[MAX_TAG] = {};
+    uint32_t value_len_[MAX_TAG] = {};
+};
+
+#endif  // FIX_ENGINE_HPP
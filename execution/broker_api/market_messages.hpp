@@ -0,0 +1,109 @@
+#ifndef MARKET_MESSAGES_HPP
+#define MARKET_MESSAGES_HPP
+
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+#include <memory>
+#include <new>
+#include <type_traits>
+
+// Fixed-layout binary message types for the market data and order paths.
+//
+// Every tick used to travel as a heap-allocated std::string that strategies
+// then parsed as text; at feed rates the allocator was the hottest symbol in
+// the profile. These PODs are trivially copyable, fit in a cache line, and can
+// be memcpy'd through rings and written to capture files without any
+// serialization step. Prices are fixed-point int64 tick counts (no doubles on
+// the wire), symbols are dense interned ids, and both exchange and local
+// receive timestamps ride along for latency attribution.
+
+// Price is an integer count of minimum price increments. PRICE_SCALE converts
+// to/from a display double on cold paths only.
+using PriceTicks = int64_t;
+constexpr double PRICE_SCALE = 1e4;  // 4 implied decimals
+
+inline PriceTicks to_price_ticks(double price) {
+    return static_cast<PriceTicks>(price * PRICE_SCALE + (price >= 0 ? 0.5 : -0.5));
+}
+
+inline double from_price_ticks(PriceTicks ticks) {
+    return static_cast<double>(ticks) / PRICE_SCALE;
+}
+
+enum class Side : uint8_t { BUY = 0, SELL = 1 };
+
+// One market data update. 40 bytes, single cache line with room to spare.
+struct MarketTick {
+    uint64_t exchange_ts_ns;   // Exchange-stamped event time
+    uint64_t local_rx_ts_ns;   // Local clock at socket read, for tick-to-trade
+    PriceTicks price;          // Fixed-point price
+    uint32_t size;             // Shares/contracts at this print or level
+    uint32_t symbol_id;        // Dense interned symbol id
+    uint16_t venue_id;         // Venue the update came from
+    uint8_t side;              // Side of the update (Side enum)
+    uint8_t flags;             // Reserved: trade/quote/imbalance markers
+};
+
+static_assert(std::is_trivially_copyable<MarketTick>::value, "MarketTick must be memcpy-able");
+static_assert(sizeof(MarketTick) == 40, "MarketTick layout changed; fix capture format consumers");
+
+// One outbound order instruction. Same design rules as MarketTick.
+struct OrderMsg {
+    uint64_t submit_ts_ns;     // Local clock at submit, for egress latency
+    PriceTicks price;          // Fixed-point limit price
+    uint32_t order_id;         // OrderManager-assigned id
+    uint32_t quantity;         // Order size
+    uint32_t symbol_id;        // Dense interned symbol id
+    uint16_t venue_id;         // Destination venue
+    uint8_t side;              // Side enum
+    uint8_t action;            // OrderAction enum below
+};
+
+enum class OrderAction : uint8_t { NEW = 0, CANCEL = 1, REPLACE = 2 };
+
+static_assert(std::is_trivially_copyable<OrderMsg>::value, "OrderMsg must be memcpy-able");
+static_assert(sizeof(OrderMsg) == 32, "OrderMsg layout changed; fix journal consumers");
+
+// Per-connection bump arena for message-sized allocations on the parse path.
+//
+// Each connector owns one arena and is the only thread touching it, so
+// allocation is a pointer bump with no lock and no thread-local lookup. The
+// arena is reset wholesale between parse batches — messages are consumed (or
+// copied into a ring) before the next batch begins, so nothing is ever freed
+// individually. Falling off the end fails loudly rather than growing: a parse
+// batch that outruns the arena is a sizing bug we want to see in testing.
+class MessageArena {
+public:
+    explicit MessageArena(std::size_t capacity_bytes)
+        : buffer_(new std::byte[capacity_bytes]), capacity_(capacity_bytes), offset_(0) {}
+
+    MessageArena(const MessageArena&) = delete;
+    MessageArena& operator=(const MessageArena&) = delete;
+
+    // Allocate one T from the arena. Returns nullptr when exhausted.
+    template <typename T>
+    T* alloc() {
+        static_assert(std::is_trivially_destructible<T>::value,
+                      "Arena types must not need destruction; reset() never runs destructors");
+        const std::size_t aligned = (offset_ + alignof(T) - 1) & ~(alignof(T) - 1);
+        if (aligned + sizeof(T) > capacity_) {
+            return nullptr;
+        }
+        offset_ = aligned + sizeof(T);
+        return new (buffer_.get() + aligned) T{};
+    }
+
+    // Reclaim everything allocated since the last reset. O(1).
+    void reset() { offset_ = 0; }
+
+    std::size_t bytes_used() const { return offset_; }
+    std::size_t capacity() const { return capacity_; }
+
+private:
+    std::unique_ptr<std::byte[]> buffer_;
+    std::size_t capacity_;
+    std::size_t offset_;
+};
+
+#endif  // MARKET_MESSAGES_HPP
@@ -0,0 +1,204 @@
+#ifndef ORDER_BOOK_HPP
+#define ORDER_BOOK_HPP
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+
+#include "market_messages.hpp"
+
+// Flat-array L2 order book.
+//
+// Price levels live in two contiguous arrays (one per side) indexed by price
+// offset from a per-side anchor tick — not a std::map. A level update is an
+// array store plus best-pointer maintenance; best bid/ask is a field read.
+// That layout is the whole feature: full-depth feeds hammer set_level at
+// millions of updates per second, and every level touched is a predictable
+// contiguous access instead of a pointer chase through tree nodes.
+//
+// The window covers DEPTH price increments per side around where trading
+// started; if price walks outside the window the side is re-anchored (a
+// memmove of the still-relevant levels — rare, and bounded).
+class OrderBook {
+public:
+    static constexpr int DEPTH = 4096;  // Price increments tracked per side
+
+    struct Level {
+        PriceTicks price = 0;
+        uint32_t size = 0;
+        bool valid = false;
+    };
+
+    struct SweepResult {
+        int64_t cost_ticks = 0;   // Sum of price_ticks * shares filled
+        uint32_t filled = 0;      // Shares available within the book
+        double avg_price() const {
+            return filled == 0 ? 0.0
+                               : static_cast<double>(cost_ticks) / filled / PRICE_SCALE;
+        }
+    };
+
+    // `tick_increment` is the venue's minimum price increment in PriceTicks
+    // units (100 = one cent at 4 implied decimals).
+    explicit OrderBook(PriceTicks tick_increment = 100) : tick_inc_(tick_increment) {}
+
+    // Absolute L2 level set: size replaces the level, 0 deletes it.
+    void set_level(Side side, PriceTicks price, uint32_t size) {
+        BookSide& book = (side == Side::BUY) ? bids_ : asks_;
+        const int offset = offsetFor(book, price);
+        if (offset < 0) {
+            return;  // Un-anchorable garbage price; drop the update
+        }
+        book.qty[offset] = size;
+        if (size > 0) {
+            if (book.best < 0 || better(side, offset, book.best)) {
+                book.best = offset;
+            }
+        } else if (offset == book.best) {
+            advanceBest(side, book);
+        }
+    }
+
+    // Feed adapter: treat a quote tick as an absolute level update on its side.
+    void apply(const MarketTick& tick) {
+        set_level(static_cast<Side>(tick.side), tick.price, tick.size);
+    }
+
+    Level best_bid() const { return bestOf(bids_); }
+    Level best_ask() const { return bestOf(asks_); }
+
+    // Cost to take `quantity` shares: walks levels from the inside outward on
+    // the side a taker of `taker_side` would hit (a buyer sweeps asks).
+    // Returns the shares actually available and their total cost in ticks.
+    SweepResult sweep_cost(Side taker_side, uint32_t quantity) const {
+        const BookSide& book = (taker_side == Side::BUY) ? asks_ : bids_;
+        const Side maker_side = (taker_side == Side::BUY) ? Side::SELL : Side::BUY;
+        SweepResult result;
+        if (book.best < 0) {
+            return result;
+        }
+        const int step = (maker_side == Side::BUY) ? -1 : 1;  // Toward worse prices
+        for (int offset = book.best; offset >= 0 && offset < DEPTH && result.filled < quantity;
+             offset += step) {
+            const uint32_t available = book.qty[offset];
+            if (available == 0) {
+                continue;
+            }
+            const uint32_t take = std::min(available, quantity - result.filled);
+            result.cost_ticks += static_cast<int64_t>(priceAt(book, offset)) * take;
+            result.filled += take;
+        }
+        return result;
+    }
+
+    // Shares available at prices no worse than `limit_price` for a taker of
+    // `taker_side` (a buyer counts ask levels priced at or below the limit).
+    uint32_t available_within(Side taker_side, PriceTicks limit_price) const {
+        const BookSide& book = (taker_side == Side::BUY) ? asks_ : bids_;
+        const Side maker_side = (taker_side == Side::BUY) ? Side::SELL : Side::BUY;
+        if (book.best < 0) {
+            return 0;
+        }
+        uint32_t total = 0;
+        const int step = (maker_side == Side::BUY) ? -1 : 1;
+        for (int offset = book.best; offset >= 0 && offset < DEPTH; offset += step) {
+            const PriceTicks price = priceAt(book, offset);
+            if (maker_side == Side::BUY ? price < limit_price : price > limit_price) {
+                break;
+            }
+            total += book.qty[offset];
+        }
+        return total;
+    }
+
+    void clear() {
+        bids_ = BookSide{};
+        asks_ = BookSide{};
+    }
+
+private:
+    struct BookSide {
+        std::array<uint32_t, DEPTH> qty{};
+        PriceTicks anchor = 0;  // Price of offset 0
+        int best = -1;          // Offset of the inside, -1 when empty
+        bool anchored = false;
+    };
+
+    // Bids improve upward in price (higher offset), asks downward.
+    static bool better(Side side, int a, int b) {
+        return side == Side::BUY ? a > b : a < b;
+    }
+
+    PriceTicks priceAt(const BookSide& book, int offset) const {
+        return book.anchor + static_cast<PriceTicks>(offset) * tick_inc_;
+    }
+
+    // Map a price to its array offset, anchoring the side on first use and
+    // re-anchoring (slow path) if price escapes the window.
+    int offsetFor(BookSide& book, PriceTicks price) {
+        if (!book.anchored) {
+            book.anchor = price - static_cast<PriceTicks>(DEPTH / 2) * tick_inc_;
+            book.anchored = true;
+        }
+        const PriceTicks delta = price - book.anchor;
+        if (delta % tick_inc_ != 0) {
+            return -1;  // Off-grid price: not representable at this increment
+        }
+        long offset = delta / tick_inc_;
+        if (offset < 0 || offset >= DEPTH) {
+            rebase(book, price);
+            offset = (price - book.anchor) / tick_inc_;
+            if (offset < 0 || offset >= DEPTH) {
+                return -1;
+            }
+        }
+        return static_cast<int>(offset);
+    }
+
+    // Re-center the window on `price`, sliding surviving levels over.
+    void rebase(BookSide& book, PriceTicks price) {
+        const PriceTicks new_anchor = price - static_cast<PriceTicks>(DEPTH / 2) * tick_inc_;
+        const long shift = (new_anchor - book.anchor) / tick_inc_;  // Old offset of new offset 0
+        std::array<uint32_t, DEPTH> moved{};
+        for (int i = 0; i < DEPTH; ++i) {
+            const long old_offset = i + shift;
+            if (old_offset >= 0 && old_offset < DEPTH) {
+                moved[i] = book.qty[old_offset];
+            }
+        }
+        book.qty = moved;
+        book.anchor = new_anchor;
+        if (book.best >= 0) {
+            const long new_best = book.best - shift;
+            book.best = (new_best >= 0 && new_best < DEPTH) ? static_cast<int>(new_best) : -1;
+        }
+    }
+
+    Level bestOf(const BookSide& book) const {
+        Level level;
+        if (book.best >= 0) {
+            level.price = priceAt(book, book.best);
+            level.size = book.qty[book.best];
+            level.valid = true;
+        }
+        return level;
+    }
+
+    // The inside emptied: scan toward worse prices for the next level.
+    void advanceBest(Side side, BookSide& book) {
+        const int step = (side == Side::BUY) ? -1 : 1;
+        for (int offset = book.best + step; offset >= 0 && offset < DEPTH; offset += step) {
+            if (book.qty[offset] > 0) {
+                book.best = offset;
+                return;
+            }
+        }
+        book.best = -1;
+    }
+
+    BookSide bids_;
+    BookSide asks_;
+    PriceTicks tick_inc_;
+};
+
+#endif  // ORDER_BOOK_HPP
@@ -0,0 +1,134 @@
+#ifndef SPSC_RING_BUFFER_HPP
+#define SPSC_RING_BUFFER_HPP
+
+#include <atomic>
+#include <array>
+#include <cstddef>
+#include <utility>
+
+// Destructive cache-line size used for padding. 64 bytes covers x86; the
+// producer and consumer indexes must never share a line or every push/pop
+// turns into a coherence round-trip between the two cores.
+constexpr std::size_t CACHE_LINE_SIZE = 64;
+
+// Bounded single-producer / single-consumer lock-free ring buffer.
+//
+// Exactly one thread may call the push-side functions and exactly one thread
+// may call the pop-side functions. Under that contract every operation is
+// wait-free: a push is one store to the slot plus one release store of the
+// index, a pop is the mirror image. No mutex, no syscall, no allocation after
+// construction.
+//
+// Capacity must be a power of two so the index wrap is a mask, not a modulo.
+template <typename T, std::size_t Capacity>
+class SPSCRingBuffer {
+    static_assert((Capacity & (Capacity - 1)) == 0, "Capacity must be a power of two");
+    static_assert(Capacity >= 2, "Capacity must be at least 2");
+
+public:
+    SPSCRingBuffer() : head_(0), tail_(0), cached_head_(0), cached_tail_(0) {}
+
+    SPSCRingBuffer(const SPSCRingBuffer&) = delete;
+    SPSCRingBuffer& operator=(const SPSCRingBuffer&) = delete;
+
+    // Producer side: attempt to enqueue one element. Returns false when the
+    // ring is full; the caller decides whether to drop, retry, or back off.
+    bool try_push(T&& item) {
+        const std::size_t tail = tail_.load(std::memory_order_relaxed);
+        const std::size_t next = (tail + 1) & mask_;
+        if (next == cached_head_) {
+            // Refresh the cached consumer index only when we appear full so
+            // the common case never reads the consumer's cache line.
+            cached_head_ = head_.load(std::memory_order_acquire);
+            if (next == cached_head_) {
+                return false;
+            }
+        }
+        slots_[tail] = std::move(item);
+        tail_.store(next, std::memory_order_release);
+        return true;
+    }
+
+    bool try_push(const T& item) {
+        T copy(item);
+        return try_push(std::move(copy));
+    }
+
+    // Consumer side: attempt to dequeue one element into `out`. Returns false
+    // when the ring is empty.
+    bool try_pop(T& out) {
+        const std::size_t head = head_.load(std::memory_order_relaxed);
+        if (head == cached_tail_) {
+            cached_tail_ = tail_.load(std::memory_order_acquire);
+            if (head == cached_tail_) {
+                return false;
+            }
+        }
+        out = std::move(slots_[head]);
+        head_.store((head + 1) & mask_, std::memory_order_release);
+        return true;
+    }
+
+    // Consumer side: drain up to `max_items` elements into `out` with a single
+    // acquire of the producer index. Batching amortizes the coherence traffic
+    // when the consumer has fallen behind a burst.
+    std::size_t pop_batch(T* out, std::size_t max_items) {
+        const std::size_t head = head_.load(std::memory_order_relaxed);
+        const std::size_t tail = tail_.load(std::memory_order_acquire);
+        std::size_t available = (tail - head) & mask_;
+        if (available > max_items) {
+            available = max_items;
+        }
+        for (std::size_t i = 0; i < available; ++i) {
+            out[i] = std::move(slots_[(head + i) & mask_]);
+        }
+        if (available > 0) {
+            head_.store((head + available) & mask_, std::memory_order_release);
+        }
+        return available;
+    }
+
+    // Consumer side: busy-spin until an element arrives or `keep_spinning`
+    // returns false (used for shutdown). Never sleeps and never yields, so it
+    // should only run on a dedicated/pinned core.
+    template <typename StopPredicate>
+    bool spin_pop(T& out, StopPredicate keep_spinning) {
+        while (keep_spinning()) {
+            if (try_pop(out)) {
+                return true;
+            }
+#if defined(__x86_64__) || defined(_M_X64)
+            __builtin_ia32_pause();  // Let the sibling hyperthread breathe
+#endif
+        }
+        return false;
+    }
+
+    bool empty() const {
+        return head_.load(std::memory_order_acquire) == tail_.load(std::memory_order_acquire);
+    }
+
+    std::size_t size() const {
+        const std::size_t tail = tail_.load(std::memory_order_acquire);
+        const std::size_t head = head_.load(std::memory_order_acquire);
+        return (tail - head) & mask_;
+    }
+
+    static constexpr std::size_t capacity() { return Capacity - 1; }
+
+private:
+    static constexpr std::size_t mask_ = Capacity - 1;
+
+    std::array<T, Capacity> slots_;
+
+    // Consumer index, padded away from the producer index below.
+    alignas(CACHE_LINE_SIZE) std::atomic<std::size_t> head_;
+    // Producer index.
+    alignas(CACHE_LINE_SIZE) std::atomic<std::size_t> tail_;
+    // Producer-local cache of head_ and consumer-local cache of tail_; these
+    // live on the owning thread's line so the fast path is core-private.
+    alignas(CACHE_LINE_SIZE) std::size_t cached_head_;
+    alignas(CACHE_LINE_SIZE) std::size_t cached_tail_;
+};
+
+#endif  // SPSC_RING_BUFFER_HPP
@@ -0,0 +1,346 @@
+#ifndef TICK_CAPTURE_HPP
+#define TICK_CAPTURE_HPP
+
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "market_messages.hpp"
+
+// Memory-mapped binary tick capture and replay.
+//
+// The on-disk record is MarketTick itself — the same 40-byte POD that rides
+// the connector rings — so capture is a memcpy into a mapped chunk and
+// replay is a pointer walk with zero parsing. The file is chunked: the
+// writer maps one chunk at a time (no giant up-front mapping), and each
+// chunk's footer entry carries a 64-bit symbol bloom so symbol-filtered
+// replay can skip whole chunks without touching their pages.
+//
+// Layout:
+//   [CaptureHeader][records...][ChunkIndexEntry x n][SymbolCountEntry x m][CaptureTrailer]
+//
+// The footer is written on close; a capture cut short by a crash is still
+// readable record-by-record (the reader falls back to a header-only scan).
+
+constexpr uint32_t CAPTURE_MAGIC = 0x50414354;  // "TCAP"
+constexpr uint32_t CAPTURE_VERSION = 1;
+
+struct CaptureHeader {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t record_size;       // sizeof(MarketTick): layout guard
+    uint32_t records_per_chunk;
+};
+
+struct ChunkIndexEntry {
+    uint64_t symbol_bloom;      // Bit (symbol_id % 64) set per symbol present
+    uint32_t record_count;      // Records actually written in this chunk
+    uint32_t pad;
+};
+
+struct SymbolCountEntry {
+    uint32_t symbol_id;
+    uint32_t pad;
+    uint64_t tick_count;
+};
+
+struct CaptureTrailer {
+    uint64_t total_records;
+    uint64_t footer_offset;     // Byte offset of the first ChunkIndexEntry
+    uint32_t chunk_entries;
+    uint32_t symbol_entries;
+    uint32_t magic;             // CAPTURE_MAGIC again: footer integrity check
+    uint32_t pad;
+};
+
+static_assert(std::is_trivially_copyable<CaptureHeader>::value, "on-disk type");
+static_assert(std::is_trivially_copyable<ChunkIndexEntry>::value, "on-disk type");
+static_assert(std::is_trivially_copyable<CaptureTrailer>::value, "on-disk type");
+
+// Appends ticks to a capture file through a moving mmap window. Single
+// writer (the connector's reactor thread); append() is a bounds check and a
+// 40-byte store — the kernel writes pages back asynchronously.
+class TickCaptureWriter {
+public:
+    static constexpr uint32_t RECORDS_PER_CHUNK = 1u << 20;  // 40MB per chunk
+
+    bool open(const std::string& path) {
+        fd_ = ::open(path.c_str(), O_CREAT | O_RDWR | O_TRUNC, 0644);
+        if (fd_ < 0) {
+            return false;
+        }
+        CaptureHeader header{CAPTURE_MAGIC, CAPTURE_VERSION, sizeof(MarketTick), RECORDS_PER_CHUNK};
+        if (::write(fd_, &header, sizeof(header)) != sizeof(header)) {
+            ::close(fd_);
+            fd_ = -1;
+            return false;
+        }
+        return mapChunk(0);
+    }
+
+    bool is_open() const { return fd_ >= 0; }
+
+    // Hot path: one store into the current chunk; rolls the mapping forward
+    // when the chunk fills.
+    void append(const MarketTick& tick) {
+        if (chunk_ == nullptr) {
+            return;
+        }
+        if (in_chunk_ == RECORDS_PER_CHUNK) {
+            sealChunk();
+            if (!mapChunk(chunk_index_ + 1)) {
+                return;
+            }
+        }
+        chunk_[in_chunk_++] = tick;
+        current_bloom_ |= bloomBit(tick.symbol_id);
+        if (tick.symbol_id < symbol_counts_.size()) {
+            symbol_counts_[tick.symbol_id]++;
+        }
+        ++total_records_;
+    }
+
+    // Seal the capture: truncate to the data actually written, then append
+    // the chunk index, per-symbol counts, and trailer.
+    void close() {
+        if (fd_ < 0) {
+            return;
+        }
+        sealChunk();
+        const uint64_t data_end = sizeof(CaptureHeader) + total_records_ * sizeof(MarketTick);
+        if (ftruncate(fd_, static_cast<off_t>(data_end)) != 0) { /* footer still follows */ }
+        ::lseek(fd_, static_cast<off_t>(data_end), SEEK_SET);
+
+        CaptureTrailer trailer{};
+        trailer.total_records = total_records_;
+        trailer.footer_offset = data_end;
+        trailer.chunk_entries = static_cast<uint32_t>(chunk_entries_.size());
+        trailer.magic = CAPTURE_MAGIC;
+
+        writeAll(chunk_entries_.data(), chunk_entries_.size() * sizeof(ChunkIndexEntry));
+        std::vector<SymbolCountEntry> symbols;
+        for (uint32_t id = 0; id < symbol_counts_.size(); ++id) {
+            if (symbol_counts_[id] > 0) {
+                symbols.push_back(SymbolCountEntry{id, 0, symbol_counts_[id]});
+            }
+        }
+        trailer.symbol_entries = static_cast<uint32_t>(symbols.size());
+        writeAll(symbols.data(), symbols.size() * sizeof(SymbolCountEntry));
+        writeAll(&trailer, sizeof(trailer));
+        ::close(fd_);
+        fd_ = -1;
+    }
+
+    uint64_t records_written() const { return total_records_; }
+
+    ~TickCaptureWriter() { close(); }
+
+private:
+    static uint64_t bloomBit(uint32_t symbol_id) { return 1ULL << (symbol_id & 63); }
+
+    static constexpr std::size_t CHUNK_BYTES = RECORDS_PER_CHUNK * sizeof(MarketTick);
+
+    bool mapChunk(uint32_t index) {
+        const off_t offset = static_cast<off_t>(sizeof(CaptureHeader)) +
+                             static_cast<off_t>(index) * static_cast<off_t>(CHUNK_BYTES);
+        // Chunk offsets are not page-aligned (the header precedes them), so
+        // map from the containing page.
+        const off_t page = offset & ~static_cast<off_t>(4095);
+        if (ftruncate(fd_, offset + static_cast<off_t>(CHUNK_BYTES)) != 0) {
+            return false;
+        }
+        void* mem = mmap(nullptr, CHUNK_BYTES + static_cast<std::size_t>(offset - page),
+                         PROT_READ | PROT_WRITE, MAP_SHARED, fd_, page);
+        if (mem == MAP_FAILED) {
+            chunk_ = nullptr;
+            return false;
+        }
+        map_base_ = mem;
+        map_len_ = CHUNK_BYTES + static_cast<std::size_t>(offset - page);
+        chunk_ = reinterpret_cast<MarketTick*>(static_cast<char*>(mem) + (offset - page));
+        chunk_index_ = index;
+        in_chunk_ = 0;
+        current_bloom_ = 0;
+        return true;
+    }
+
+    void sealChunk() {
+        if (map_base_ != nullptr) {
+            chunk_entries_.push_back(ChunkIndexEntry{current_bloom_, in_chunk_, 0});
+            munmap(map_base_, map_len_);
+            map_base_ = nullptr;
+            chunk_ = nullptr;
+        }
+    }
+
+    void writeAll(const void* data, std::size_t len) {
+        if (len > 0) {
+            ssize_t written = ::write(fd_, data, len);
+            (void)written;
+        }
+    }
+
+    int fd_ = -1;
+    void* map_base_ = nullptr;
+    std::size_t map_len_ = 0;
+    MarketTick* chunk_ = nullptr;
+    uint32_t chunk_index_ = 0;
+    uint32_t in_chunk_ = 0;
+    uint64_t current_bloom_ = 0;
+    uint64_t total_records_ = 0;
+    std::vector<ChunkIndexEntry> chunk_entries_;
+    std::vector<uint64_t> symbol_counts_ = std::vector<uint64_t>(1024, 0);
+};
+
+// Streams a capture back through a callback, at max speed or at wall-clock
+// pace, straight off the mapping — no copies, no parsing. The callback gets
+// the same MarketTick the strategies consume live, so a replayed day runs
+// the identical hot path.
+class TickReplayer {
+public:
+    enum class Pace { MAX_SPEED, WALL_CLOCK };
+
+    bool open(const std::string& path) {
+        fd_ = ::open(path.c_str(), O_RDONLY);
+        if (fd_ < 0) {
+            return false;
+        }
+        struct stat st{};
+        if (fstat(fd_, &st) != 0 || static_cast<std::size_t>(st.st_size) < sizeof(CaptureHeader)) {
+            ::close(fd_);
+            fd_ = -1;
+            return false;
+        }
+        file_len_ = static_cast<std::size_t>(st.st_size);
+        void* mem = mmap(nullptr, file_len_, PROT_READ, MAP_SHARED, fd_, 0);
+        if (mem == MAP_FAILED) {
+            ::close(fd_);
+            fd_ = -1;
+            return false;
+        }
+        base_ = static_cast<const char*>(mem);
+        const auto* header = reinterpret_cast<const CaptureHeader*>(base_);
+        if (header->magic != CAPTURE_MAGIC || header->version != CAPTURE_VERSION ||
+            header->record_size != sizeof(MarketTick)) {
+            closeMap();
+            return false;
+        }
+        records_per_chunk_ = header->records_per_chunk;
+        records_ = reinterpret_cast<const MarketTick*>(base_ + sizeof(CaptureHeader));
+        loadFooter();
+        // Tell the kernel we will stream the whole thing front to back.
+        madvise(const_cast<char*>(base_), file_len_, MADV_SEQUENTIAL);
+        return true;
+    }
+
+    uint64_t record_count() const { return total_records_; }
+
+    // Symbols present in the capture, with tick totals (footer-backed).
+    const std::vector<SymbolCountEntry>& symbol_entries() const { return symbol_counts_; }
+
+    // Ticks captured for one symbol (from the footer; 0 if footer missing).
+    uint64_t symbol_tick_count(uint32_t symbol_id) const {
+        for (const auto& entry : symbol_counts_) {
+            if (entry.symbol_id == symbol_id) {
+                return entry.tick_count;
+            }
+        }
+        return 0;
+    }
+
+    // Replay every tick. At WALL_CLOCK pace, inter-tick gaps reproduce the
+    // captured exchange timestamp deltas.
+    template <typename Callback>
+    void replay(Callback&& callback, Pace pace = Pace::MAX_SPEED) const {
+        const uint64_t base_ts = total_records_ > 0 ? records_[0].exchange_ts_ns : 0;
+        const auto start = std::chrono::steady_clock::now();
+        for (uint64_t i = 0; i < total_records_; ++i) {
+            const MarketTick& tick = records_[i];
+            if (pace == Pace::WALL_CLOCK && tick.exchange_ts_ns > base_ts) {
+                const auto due = start + std::chrono::nanoseconds(tick.exchange_ts_ns - base_ts);
+                std::this_thread::sleep_until(due);
+            }
+            callback(tick);
+        }
+    }
+
+    // Replay only one symbol's ticks, skipping chunks whose bloom filter
+    // rules the symbol out — a cold symbol costs one footer read per chunk,
+    // not a page-in of 40MB of other people's ticks.
+    template <typename Callback>
+    void replay_symbol(uint32_t symbol_id, Callback&& callback) const {
+        const uint64_t bit = 1ULL << (symbol_id & 63);
+        uint64_t record = 0;
+        for (std::size_t c = 0; c < chunk_entries_.size(); ++c) {
+            const ChunkIndexEntry& chunk = chunk_entries_[c];
+            if ((chunk.symbol_bloom & bit) != 0) {
+                for (uint32_t i = 0; i < chunk.record_count; ++i) {
+                    const MarketTick& tick = records_[record + i];
+                    if (tick.symbol_id == symbol_id) {
+                        callback(tick);
+                    }
+                }
+            }
+            record += chunk.record_count;
+        }
+        if (chunk_entries_.empty()) {
+            // No footer (crashed capture): fall back to a full scan.
+            for (uint64_t i = 0; i < total_records_; ++i) {
+                if (records_[i].symbol_id == symbol_id) {
+                    callback(records_[i]);
+                }
+            }
+        }
+    }
+
+    ~TickReplayer() { closeMap(); }
+
+private:
+    void loadFooter() {
+        if (file_len_ >= sizeof(CaptureHeader) + sizeof(CaptureTrailer)) {
+            const auto* trailer =
+                reinterpret_cast<const CaptureTrailer*>(base_ + file_len_ - sizeof(CaptureTrailer));
+            if (trailer->magic == CAPTURE_MAGIC &&
+                trailer->footer_offset <= file_len_ - sizeof(CaptureTrailer)) {
+                total_records_ = trailer->total_records;
+                const auto* chunks = reinterpret_cast<const ChunkIndexEntry*>(base_ + trailer->footer_offset);
+                chunk_entries_.assign(chunks, chunks + trailer->chunk_entries);
+                const auto* symbols = reinterpret_cast<const SymbolCountEntry*>(chunks + trailer->chunk_entries);
+                symbol_counts_.assign(symbols, symbols + trailer->symbol_entries);
+                return;
+            }
+        }
+        // Footer missing: every whole record before EOF is replayable.
+        total_records_ = (file_len_ - sizeof(CaptureHeader)) / sizeof(MarketTick);
+    }
+
+    void closeMap() {
+        if (base_ != nullptr) {
+            munmap(const_cast<char*>(base_), file_len_);
+            base_ = nullptr;
+        }
+        if (fd_ >= 0) {
+            ::close(fd_);
+            fd_ = -1;
+        }
+    }
+
+    int fd_ = -1;
+    const char* base_ = nullptr;
+    std::size_t file_len_ = 0;
+    const MarketTick* records_ = nullptr;
+    uint64_t total_records_ = 0;
+    uint32_t records_per_chunk_ = 0;
+    std::vector<ChunkIndexEntry> chunk_entries_;
+    std::vector<SymbolCountEntry> symbol_counts_;
+};
+
+#endif  // TICK_CAPTURE_HPP
@@ -0,0 +1,121 @@
+#ifndef EXECUTION_SCHEDULER_HPP
+#define EXECUTION_SCHEDULER_HPP
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <vector>
+
+// Shared slice scheduler for execution algorithms.
+//
+// TWAP/VWAP parents used to burn a dedicated thread each, sleeping between
+// slices — 200+ concurrent parent orders meant 200+ threads whose sleep_for
+// wakeups jittered by tens of milliseconds. Here every slice across every
+// parent order is an entry on one time-ordered priority queue serviced by a
+// small fixed pool (one or two threads): workers sleep exactly until the next
+// due slice, pop everything that is ripe, and run the callbacks outside the
+// lock. Scheduling a slice is O(log n) in outstanding slices; the thread
+// count is constant regardless of how many parents are working.
+class ExecutionScheduler {
+public:
+    using Clock = std::chrono::steady_clock;
+    using Callback = std::function<void()>;
+
+    explicit ExecutionScheduler(unsigned num_threads = 1) : running_(true) {
+        for (unsigned i = 0; i < num_threads; ++i) {
+            workers_.emplace_back(&ExecutionScheduler::workerLoop, this);
+        }
+    }
+
+    ~ExecutionScheduler() { stop(); }
+
+    ExecutionScheduler(const ExecutionScheduler&) = delete;
+    ExecutionScheduler& operator=(const ExecutionScheduler&) = delete;
+
+    // Schedule a callback to run at `due`. Thread-safe; callable from slice
+    // callbacks themselves (that is how a parent order re-arms its next
+    // slice after looking at the market).
+    void schedule(Clock::time_point due, Callback callback) {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            queue_.push(Task{due, next_seq_++, std::move(callback)});
+        }
+        cv_.notify_one();
+    }
+
+    void scheduleAfter(Clock::duration delay, Callback callback) {
+        schedule(Clock::now() + delay, std::move(callback));
+    }
+
+    void stop() {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (!running_) {
+                return;
+            }
+            running_ = false;
+        }
+        cv_.notify_all();
+        for (auto& worker : workers_) {
+            if (worker.joinable()) {
+                worker.join();
+            }
+        }
+    }
+
+    std::size_t pendingSlices() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return queue_.size();
+    }
+
+private:
+    struct Task {
+        Clock::time_point due;
+        uint64_t seq;  // Tie-breaker: equal-due tasks run in submit order
+        Callback callback;
+    };
+
+    struct TaskLater {
+        bool operator()(const Task& a, const Task& b) const {
+            if (a.due != b.due) {
+                return a.due > b.due;
+            }
+            return a.seq > b.seq;
+        }
+    };
+
+    void workerLoop() {
+        std::unique_lock<std::mutex> lock(mutex_);
+        while (running_) {
+            if (queue_.empty()) {
+                cv_.wait(lock, [this] { return !running_ || !queue_.empty(); });
+                continue;
+            }
+            const Clock::time_point next_due = queue_.top().due;
+            if (Clock::now() < next_due) {
+                // Sleep exactly until the next slice is due (or a new,
+                // earlier slice arrives and re-notifies us).
+                cv_.wait_until(lock, next_due);
+                continue;
+            }
+            Task task = std::move(const_cast<Task&>(queue_.top()));
+            queue_.pop();
+            lock.unlock();
+            task.callback();  // Never run user code under the queue lock
+            lock.lock();
+        }
+    }
+
+    std::priority_queue<Task, std::vector<Task>, TaskLater> queue_;
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    std::vector<std::thread> workers_;
+    bool running_;
+    uint64_t next_seq_ = 0;
+};
+
+#endif  // EXECUTION_SCHEDULER_HPP
@@ -5,6 +5,10 @@
 #include <cmath>
 #include <algorithm>
 #include <stdexcept>
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include "execution_scheduler.hpp"
 
 // TWAP Algorithm for time-weighted average execution of large orders
 class TWAPExecution {
@@ -15,6 +19,19 @@ private:
     int executedVolume; 
     std::chrono::time_point<std::chrono::steady_clock> startTime; 
     std::vector<int> orderSchedule; 
+    std::mutex completionMutex;
+    std::condition_variable completionCv;
+    bool complete = false;
+
+    // Adaptive mode state. Realized volume is accumulated by the feed thread
+    // into an atomic counter and folded into an EMA once per interval, so a
+    // replan is three arithmetic ops — never a schedule-vector rebuild.
+    bool adaptive = false;
+    std::atomic<long long> intervalVolume{0};
+    double emaIntervalVolume = 0.0;
+    static constexpr double EMA_ALPHA = 0.2;          // Interval-volume smoothing
+    static constexpr double MIN_SLICE_FACTOR = 0.5;   // Thin interval: hold back
+    static constexpr double MAX_SLICE_FACTOR = 2.0;   // Busy interval: lean in
 
     // Validate the input parameters to ensure correct configuration
     void validateParameters() {
@@ -53,13 +70,12 @@ private:
         std::cout << std::endl;
     }
 
-    // Method to simulate the execution of an order slice
+    // Method to execute one order slice. Runs on a scheduler worker; must
+    // never sleep or block — hundreds of parent orders share those threads.
     void executeSlice(int volume) {
         try {
-            // Simulate actual execution (connecting to a broker API)
+            // Hand the slice to the order path (broker API)
             std::cout << "Executing slice with volume: " << volume << std::endl;
-            // Simulate network latency or exchange processing time
-            std::this_thread::sleep_for(std::chrono::seconds(1));
 
             // Log successful execution
             std::cout << "Successfully executed slice of volume: " << volume << std::endl;
@@ -69,15 +85,87 @@ private:
         }
     }
 
+    // Scheduler callback: execute the due slice, then arm the next one at
+    // its absolute due time (startTime + n*interval, so slices never drift
+    // the way chained sleep_for did).
+    void onSliceDue(ExecutionScheduler& scheduler, std::size_t slice_index) {
+        auto now = std::chrono::steady_clock::now();
+        auto elapsedTime = std::chrono::duration_cast<std::chrono::seconds>(now - startTime).count();
+
+        if (elapsedTime >= totalDuration) {
+            std::cout << "Total execution time exceeded. Ending execution." << std::endl;
+            markComplete();
+            return;
+        }
+
+        bool done;
+        if (adaptive) {
+            done = executeAdaptiveSlice(elapsedTime);
+        } else {
+            executeSlice(orderSchedule[slice_index]);
+            done = slice_index + 1 >= orderSchedule.size();
+        }
+
+        if (done) {
+            std::cout << "TWAP execution complete. Total executed volume: " << executedVolume << std::endl;
+            markComplete();
+            return;
+        }
+        auto next_due = startTime + std::chrono::seconds(timeInterval * static_cast<long>(slice_index + 1));
+        scheduler.schedule(next_due, [this, &scheduler, slice_index] {
+            onSliceDue(scheduler, slice_index + 1);
+        });
+    }
+
+    // Adaptive replan + execute for one interval. O(1): fold the interval's
+    // realized volume into the EMA, scale the even-pace slice by how busy
+    // the interval was (clamped so a dead tape still makes progress and a
+    // burst cannot blow the order out early), and send it.
+    bool executeAdaptiveSlice(long long elapsedSeconds) {
+        const long long realized = intervalVolume.exchange(0, std::memory_order_relaxed);
+        if (emaIntervalVolume <= 0.0) {
+            emaIntervalVolume = static_cast<double>(realized);
+        } else {
+            emaIntervalVolume = EMA_ALPHA * static_cast<double>(realized) + (1.0 - EMA_ALPHA) * emaIntervalVolume;
+        }
+
+        const int remaining = totalOrderSize - executedVolume;
+        const long long secondsLeft = totalDuration - elapsedSeconds;
+        const int slicesLeft = std::max(1, static_cast<int>(secondsLeft / timeInterval));
+        const double baseSlice = static_cast<double>(remaining) / slicesLeft;
+
+        double factor = 1.0;
+        if (emaIntervalVolume > 0.0) {
+            factor = static_cast<double>(realized) / emaIntervalVolume;
+            factor = std::min(MAX_SLICE_FACTOR, std::max(MIN_SLICE_FACTOR, factor));
+        }
+
+        const int volume = std::min(remaining, std::max(1, static_cast<int>(baseSlice * factor)));
+        executedVolume += volume;
+        executeSlice(volume);
+        return executedVolume >= totalOrderSize;
+    }
+
+    void markComplete() {
+        {
+            std::lock_guard<std::mutex> lock(completionMutex);
+            complete = true;
+        }
+        completionCv.notify_all();
+    }
+
     // Check whether the total order has been executed
     bool isExecutionComplete() {
         return executedVolume >= totalOrderSize;
     }
 
 public:
-    // Constructor to initialize TWAP execution parameters
-    TWAPExecution(int totalOrderSize, int timeInterval, int totalDuration)
-        : totalOrderSize(totalOrderSize), timeInterval(timeInterval), totalDuration(totalDuration), executedVolume(0) {
+    // Constructor to initialize TWAP execution parameters. With
+    // adaptiveSlicing the equal-slice schedule is skipped entirely: slice
+    // sizes are decided interval by interval from realized volume.
+    TWAPExecution(int totalOrderSize, int timeInterval, int totalDuration, bool adaptiveSlicing = false)
+        : totalOrderSize(totalOrderSize), timeInterval(timeInterval), totalDuration(totalDuration), executedVolume(0),
+          adaptive(adaptiveSlicing) {
         
         try {
             // Validate the input parameters
@@ -86,8 +174,10 @@ public:
             // Set the start time for the execution
             startTime = std::chrono::steady_clock::now();
 
-            // Calculate the schedule for executing the order
-            calculateOrderSchedule();
+            if (!adaptive) {
+                // Calculate the static schedule for executing the order
+                calculateOrderSchedule();
+            }
 
         } catch (const std::invalid_argument& e) {
             std::cerr << "Initialization error: " << e.what() << std::endl;
@@ -95,36 +185,33 @@ public:
         }
     }
 
-    // Method to execute the TWAP strategy
-    void execute() {
-        try {
-            std::cout << "Starting TWAP execution..." << std::endl;
-
-            // Iterate through the order schedule and execute each slice
-            for (int volume : orderSchedule) {
-                auto now = std::chrono::steady_clock::now();
-                auto elapsedTime = std::chrono::duration_cast<std::chrono::seconds>(now - startTime).count();
-
-                if (elapsedTime < totalDuration) {
-                    executeSlice(volume);
-
-                    // Sleep for the specified time interval before next slice execution
-                    std::this_thread::sleep_for(std::chrono::seconds(timeInterval));
-
-                } else {
-                    std::cout << "Total execution time exceeded. Ending execution." << std::endl;
-                    break;
-                }
+    // Feed hook for adaptive mode: called per tick (any thread) with the
+    // tick's traded volume. One relaxed atomic add; the MarketData volume
+    // from the connector feed plugs straight in here.
+    void onMarketData(double tickVolume) {
+        intervalVolume.fetch_add(static_cast<long long>(tickVolume), std::memory_order_relaxed);
+    }
 
-                // Check if execution is complete
-                if (isExecutionComplete()) {
-                    std::cout << "TWAP execution complete. Total executed volume: " << executedVolume << std::endl;
-                    break;
-                }
-            }
-        } catch (const std::exception& e) {
-            std::cerr << "Execution error: " << e.what() << std::endl;
+    // Start the TWAP on a shared scheduler: the first slice fires
+    // immediately and each slice re-arms the next at its absolute due time.
+    // Returns at once; the parent order lives on the scheduler's queue, not
+    // on a thread of its own.
+    void start(ExecutionScheduler& scheduler) {
+        std::cout << "Starting TWAP execution..." << std::endl;
+        startTime = std::chrono::steady_clock::now();
+        if (!adaptive && orderSchedule.empty()) {
+            markComplete();
+            return;
         }
+        scheduler.schedule(startTime, [this, &scheduler] {
+            onSliceDue(scheduler, 0);
+        });
+    }
+
+    // Block the caller until every slice has run (or execution timed out).
+    void waitUntilComplete() {
+        std::unique_lock<std::mutex> lock(completionMutex);
+        completionCv.wait(lock, [this] { return complete; });
     }
 
     // Method to handle any cleanup activities
@@ -144,14 +231,24 @@ int main() {
         int timeInterval = 5;     
         int totalDuration = 60;    
 
-        // Create the TWAP execution object
+        // One scheduler services every concurrent parent order; two worker
+        // threads are plenty since slice callbacks never block.
+        ExecutionScheduler scheduler(2);
+
+        // Create the TWAP execution objects — both share the scheduler
         TWAPExecution twap(totalOrderSize, timeInterval, totalDuration);
+        TWAPExecution twap2(5000, timeInterval, totalDuration);
+
+        // Start both parent orders; neither owns a thread
+        twap.start(scheduler);
+        twap2.start(scheduler);
 
-        // Start execution of the TWAP algorithm
-        twap.execute();
+        twap.waitUntilComplete();
+        twap2.waitUntilComplete();
 
         // Perform any cleanup or finalization
         twap.finalize();
+        twap2.finalize();
 
     } catch (const std::exception& e) {
         std::cerr << "Error: " << e.what() << std::endl;
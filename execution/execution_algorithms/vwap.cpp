@@ -5,6 +5,7 @@
 #include <ctime>
 #include <iomanip>
 #include <cmath>
+#include <algorithm>
 
 // Helper function to get current timestamp
 std::string getCurrentTimestamp() {
@@ -44,38 +45,117 @@ public:
 };
 
 // VWAP Execution Class
+//
+// Streaming design: market data folds into running session accumulators and a
+// fixed ring of one-second buckets, so memory is O(1) no matter how long the
+// session runs — the old grow-forever prices/volumes vectors put on ~2GB of
+// RSS per day on a liquid name. The bucket ring answers trailing-window VWAP
+// and participation-rate queries over any window up to BUCKET_COUNT seconds;
+// execution statistics are running sums rather than parallel vectors.
 class VWAPExecution {
 private:
-    std::vector<double> prices;
-    std::vector<double> volumes;
-    std::vector<double> executionPrices;
-    std::vector<double> executionVolumes;
+    // One second of (price*volume, volume), tagged with its epoch second so
+    // stale slots from a previous lap of the ring are recognized and skipped.
+    struct Bucket {
+        double priceVolume = 0;
+        double volume = 0;
+        std::time_t epochSecond = 0;
+    };
+
+    // ~68 minutes of one-second buckets; fixed at construction, never grows.
+    static constexpr std::size_t BUCKET_COUNT = 4096;
+
+    std::vector<Bucket> buckets;
     double totalVolume;
     double totalPriceVolume;
     VWAPLogger logger;
     int totalExecutions;
     int totalNonExecutions;
     double totalExecutedVolume;
+    double executionPriceVolume;
 
 public:
     VWAPExecution(const std::string &logFilename)
-        : totalVolume(0), totalPriceVolume(0), logger(logFilename), totalExecutions(0), totalNonExecutions(0), totalExecutedVolume(0) {}
+        : buckets(BUCKET_COUNT), totalVolume(0), totalPriceVolume(0), logger(logFilename),
+          totalExecutions(0), totalNonExecutions(0), totalExecutedVolume(0), executionPriceVolume(0) {}
 
-    // Add market data (price and volume) to the computation
+    // Add market data (price and volume) to the computation. O(1): two
+    // session accumulator adds plus one bucket update.
     void addMarketData(double price, double volume) {
-        prices.push_back(price);
-        volumes.push_back(volume);
+        addMarketData(price, volume, std::time(nullptr));
+    }
 
+    // Timestamped variant so replays and tests control the clock.
+    void addMarketData(double price, double volume, std::time_t now) {
         totalPriceVolume += price * volume;
         totalVolume += volume;
+
+        Bucket &bucket = buckets[static_cast<std::size_t>(now) % BUCKET_COUNT];
+        if (bucket.epochSecond != now) {
+            // The ring has lapped; this slot belongs to a new second now.
+            bucket.priceVolume = 0;
+            bucket.volume = 0;
+            bucket.epochSecond = now;
+        }
+        bucket.priceVolume += price * volume;
+        bucket.volume += volume;
     }
 
-    // Compute the current VWAP based on collected data
+    // Compute the session VWAP based on collected data
     double calculateVWAP() const {
         if (totalVolume == 0) return 0;
         return totalPriceVolume / totalVolume;
     }
 
+    // Trailing-window VWAP over the last windowSeconds (capped at the ring
+    // depth). Scans at most windowSeconds buckets — bounded work, no
+    // allocation, independent of session length.
+    double calculateTrailingVWAP(int windowSeconds) const {
+        return calculateTrailingVWAP(windowSeconds, std::time(nullptr));
+    }
+
+    double calculateTrailingVWAP(int windowSeconds, std::time_t now) const {
+        if (windowSeconds > static_cast<int>(BUCKET_COUNT)) {
+            windowSeconds = static_cast<int>(BUCKET_COUNT);
+        }
+        double pv = 0, vol = 0;
+        for (int i = 0; i < windowSeconds; ++i) {
+            std::time_t second = now - i;
+            const Bucket &bucket = buckets[static_cast<std::size_t>(second) % BUCKET_COUNT];
+            if (bucket.epochSecond == second) {
+                pv += bucket.priceVolume;
+                vol += bucket.volume;
+            }
+        }
+        if (vol == 0) return 0;
+        return pv / vol;
+    }
+
+    // Trailing market volume over the last windowSeconds, for participation
+    // pacing.
+    double trailingMarketVolume(int windowSeconds, std::time_t now) const {
+        if (windowSeconds > static_cast<int>(BUCKET_COUNT)) {
+            windowSeconds = static_cast<int>(BUCKET_COUNT);
+        }
+        double vol = 0;
+        for (int i = 0; i < windowSeconds; ++i) {
+            std::time_t second = now - i;
+            const Bucket &bucket = buckets[static_cast<std::size_t>(second) % BUCKET_COUNT];
+            if (bucket.epochSecond == second) {
+                vol += bucket.volume;
+            }
+        }
+        return vol;
+    }
+
+    // Volume we still need to execute to hit a participation rate of the
+    // session's traded volume (clamped at zero when ahead of schedule).
+    double participationShortfall(double participationRate) const {
+        double target = participationRate * totalVolume;
+        double shortfall = target - totalExecutedVolume;
+        return shortfall > 0 ? shortfall : 0;
+    }
+
     // Execute an order based on the VWAP price and target price
     void executeOrder(double targetVWAP) {
         double currentVWAP = calculateVWAP();
@@ -84,8 +164,7 @@ public:
 
         if (currentVWAP <= targetVWAP) {
             double executionVolume = getExecutionVolume(currentVWAP, targetVWAP);
-            executionPrices.push_back(currentVWAP);
-            executionVolumes.push_back(executionVolume);
+            executionPriceVolume += currentVWAP * executionVolume;
             totalExecutions++;
             totalExecutedVolume += executionVolume;
             executed = true;
@@ -104,23 +183,21 @@ public:
         std::cout << "Total Executions: " << totalExecutions << std::endl;
         std::cout << "Total Non-Executions: " << totalNonExecutions << std::endl;
         std::cout << "Total Executed Volume: " << totalExecutedVolume << std::endl;
-        if (totalExecutions > 0) {
-            double avgExecutionPrice = std::accumulate(executionPrices.begin(), executionPrices.end(), 0.0) / totalExecutions;
+        if (totalExecutedVolume > 0) {
+            double avgExecutionPrice = executionPriceVolume / totalExecutedVolume;
             std::cout << "Average Execution Price: " << avgExecutionPrice << std::endl;
         }
     }
 
     // Reset VWAP calculation and execution statistics (for a new trading session)
     void reset() {
-        prices.clear();
-        volumes.clear();
-        executionPrices.clear();
-        executionVolumes.clear();
+        std::fill(buckets.begin(), buckets.end(), Bucket{});
         totalVolume = 0;
         totalPriceVolume = 0;
         totalExecutions = 0;
         totalNonExecutions = 0;
         totalExecutedVolume = 0;
+        executionPriceVolume = 0;
         std::cout << "VWAP execution reset for a new session.\n";
     }
 
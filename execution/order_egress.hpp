@@ -0,0 +1,373 @@
+#ifndef ORDER_EGRESS_HPP
+#define ORDER_EGRESS_HPP
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <thread>
+#include "exchange_connector.h"
+#include "symbol_table.hpp"
+#include "thread_manager.hpp"
+
+// Coalescing egress stage between OrderManager and ExchangeConnector.
+//
+// Re-quoting on every tick emits storms of modify/cancel pairs, and venues
+// throttle us for traffic that was stale before it hit the wire. This stage
+// decouples intent from transmission: each order slot has one pending-intent
+// record, and a newer modify simply overwrites an unsent older one — only
+// the latest intent ever goes out, which cuts both wire traffic and the
+// effective re-quote latency. A cancel arriving before an unsent NEW
+// annihilates the pair entirely: the venue never hears about either.
+//
+// Submit side is lock-free: the caller claims the slot with a CAS on its
+// version word (odd = being written), mutates the payload, publishes, and
+// enqueues the slot index on a Vyukov-style MPSC ring only if it is not
+// already queued. The single drain thread owns transmission: it meters
+// sends through a token bucket (the venue's order-rate allowance) and
+// issues the calls for a batch back-to-back in one wakeup so the
+// connector's socket layer can pack them into one segment.
+//
+// Slot indexes are the low bits of the OrderManager order id, so an intent
+// slot is recycled along with its order slot. If a dead order's trailing
+// cancel is still unsent when the slot is reused (needs a full lap of the
+// 8192-slot shard first), the successor's NEW overwrites it — acceptable,
+// since that order was already terminal on our side.
+class OrderEgress {
+public:
+    static constexpr int SLOT_BITS = 17;                 // Matches OrderManager's id layout
+    static constexpr int NUM_SLOTS = 1 << SLOT_BITS;
+    static constexpr int SLOT_MASK = NUM_SLOTS - 1;
+    static constexpr int BATCH_MAX = 32;
+
+    OrderEgress() : slots_(new IntentSlot[NUM_SLOTS]) {
+        for (uint64_t i = 0; i < RING_SIZE; ++i) {
+            ring_[i].seq.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    ~OrderEgress() { stop(); }
+
+    void attach(ExchangeConnector* connector) { connector_ = connector; }
+
+    void start() {
+        if (running_.exchange(true)) {
+            return;
+        }
+        drain_thread_ = ThreadManager::instance().launch(ThreadRole::ORDER_EGRESS,
+                                                         [this] { drainLoop(); });
+    }
+
+    // Drains everything still pending before the thread exits.
+    void stop() {
+        if (!running_.exchange(false)) {
+            return;
+        }
+        if (drain_thread_.joinable()) {
+            drain_thread_.join();
+        }
+    }
+
+    // Venue order-rate allowance: sustained orders per second plus a burst
+    // allowance. Atomic so the control path can retune it live; 0 = no cap.
+    void setRateLimit(uint32_t orders_per_sec, uint32_t burst) {
+        rate_per_sec_.store(orders_per_sec, std::memory_order_relaxed);
+        burst_.store(burst, std::memory_order_relaxed);
+    }
+
+    // ---- Submit side (lock-free, called from OrderManager) --------------
+
+    void submitNew(int order_id, uint32_t symbol_id, double price, int quantity, bool is_buy) {
+        IntentSlot& slot = slots_[order_id & SLOT_MASK];
+        const uint32_t v = claim(slot);
+        slot.type = IntentType::NEW;
+        slot.order_id = order_id;
+        slot.symbol_id = symbol_id;
+        slot.price = price;
+        slot.quantity = quantity;
+        slot.is_buy = is_buy;
+        release(slot, v);
+        enqueue(order_id & SLOT_MASK, slot);
+    }
+
+    void submitModify(int order_id, double new_price, int new_quantity) {
+        IntentSlot& slot = slots_[order_id & SLOT_MASK];
+        const uint32_t v = claim(slot);
+        switch (slot.type) {
+            case IntentType::NEW:
+                // The order has not left the box: fold the modify into it.
+                slot.price = new_price;
+                slot.quantity = new_quantity;
+                coalesced_.fetch_add(1, std::memory_order_relaxed);
+                break;
+            case IntentType::MODIFY:
+                // Newer intent overwrites the unsent older one.
+                slot.price = new_price;
+                slot.quantity = new_quantity;
+                coalesced_.fetch_add(1, std::memory_order_relaxed);
+                break;
+            case IntentType::CANCEL:
+            case IntentType::SUPPRESS:
+                // Cancel wins; the modify is moot.
+                coalesced_.fetch_add(1, std::memory_order_relaxed);
+                break;
+            case IntentType::NONE:
+                slot.type = IntentType::MODIFY;
+                slot.order_id = order_id;
+                slot.price = new_price;
+                slot.quantity = new_quantity;
+                break;
+        }
+        release(slot, v);
+        enqueue(order_id & SLOT_MASK, slot);
+    }
+
+    void submitCancel(int order_id) {
+        IntentSlot& slot = slots_[order_id & SLOT_MASK];
+        const uint32_t v = claim(slot);
+        if (slot.type == IntentType::NEW) {
+            // Unsent NEW + cancel annihilate: nothing goes to the wire.
+            slot.type = IntentType::SUPPRESS;
+            suppressed_.fetch_add(1, std::memory_order_relaxed);
+        } else {
+            slot.type = IntentType::CANCEL;
+            slot.order_id = order_id;
+        }
+        release(slot, v);
+        enqueue(order_id & SLOT_MASK, slot);
+    }
+
+    // ---- Stats ----------------------------------------------------------
+
+    uint64_t sentCount() const { return sent_.load(std::memory_order_relaxed); }
+    uint64_t coalescedCount() const { return coalesced_.load(std::memory_order_relaxed); }
+    uint64_t suppressedCount() const { return suppressed_.load(std::memory_order_relaxed); }
+
+private:
+    enum class IntentType : uint8_t { NONE = 0, NEW, MODIFY, CANCEL, SUPPRESS };
+
+    // Plain snapshot of a slot's payload for the drain thread to act on.
+    struct Intent {
+        IntentType type = IntentType::NONE;
+        bool is_buy = false;
+        int order_id = 0;
+        uint32_t symbol_id = 0;
+        double price = 0.0;
+        int quantity = 0;
+    };
+
+    // One pending intent per order slot, padded so adjacent slots (adjacent
+    // orders, often adjacent symbols) never false-share.
+    struct alignas(64) IntentSlot {
+        std::atomic<uint32_t> version{0};   // Odd while a writer holds the slot
+        std::atomic<uint8_t> queued{0};     // Slot index already on the ring
+        IntentType type = IntentType::NONE;
+        bool is_buy = false;
+        int order_id = 0;
+        uint32_t symbol_id = 0;
+        double price = 0.0;
+        int quantity = 0;
+    };
+
+    // Claim the slot for exclusive mutation: CAS version even -> odd.
+    static uint32_t claim(IntentSlot& slot) {
+        uint32_t v = slot.version.load(std::memory_order_relaxed);
+        for (;;) {
+            if (v & 1u) {
+                v = slot.version.load(std::memory_order_relaxed);
+                continue;
+            }
+            if (slot.version.compare_exchange_weak(v, v + 1, std::memory_order_acquire,
+                                                   std::memory_order_relaxed)) {
+                return v;
+            }
+        }
+    }
+
+    static void release(IntentSlot& slot, uint32_t claimed) {
+        slot.version.store(claimed + 2, std::memory_order_release);
+    }
+
+    void enqueue(uint32_t slot_index, IntentSlot& slot) {
+        if (slot.queued.exchange(1, std::memory_order_acq_rel) == 0) {
+            ringPush(slot_index);
+        }
+    }
+
+    // ---- MPSC ring of slot indexes (Vyukov bounded queue) ---------------
+
+    static constexpr uint32_t RING_SIZE = 1 << 15;
+    static constexpr uint32_t RING_MASK = RING_SIZE - 1;
+
+    struct RingCell {
+        std::atomic<uint64_t> seq;
+        uint32_t value;
+    };
+
+    void ringPush(uint32_t value) {
+        for (;;) {
+            uint64_t pos = ring_tail_.load(std::memory_order_relaxed);
+            RingCell& cell = ring_[pos & RING_MASK];
+            const int64_t dif = static_cast<int64_t>(cell.seq.load(std::memory_order_acquire)) -
+                                static_cast<int64_t>(pos);
+            if (dif == 0) {
+                if (ring_tail_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    cell.value = value;
+                    cell.seq.store(pos + 1, std::memory_order_release);
+                    return;
+                }
+            } else if (dif < 0) {
+                // Ring full: spin — egress backpressure is the rate limit
+                // doing its job, and losing an intent is not an option.
+                std::this_thread::yield();
+            }
+        }
+    }
+
+    bool ringPop(uint32_t& value) {
+        const uint64_t pos = ring_head_;
+        RingCell& cell = ring_[pos & RING_MASK];
+        const int64_t dif = static_cast<int64_t>(cell.seq.load(std::memory_order_acquire)) -
+                            static_cast<int64_t>(pos + 1);
+        if (dif != 0) {
+            return false;
+        }
+        value = cell.value;
+        cell.seq.store(pos + RING_SIZE, std::memory_order_release);
+        ++ring_head_;
+        return true;
+    }
+
+    // ---- Drain side (single thread) -------------------------------------
+
+    void drainLoop() {
+        int64_t last_refill_ns = nowNs();
+        double tokens = burst_.load(std::memory_order_relaxed);
+
+        while (running_.load(std::memory_order_relaxed) || pendingOnRing()) {
+            uint32_t slot_index;
+            if (!ringPop(slot_index)) {
+                ThreadManager::instance().pauseOrYield(ThreadRole::ORDER_EGRESS);
+                continue;
+            }
+
+            IntentSlot& slot = slots_[slot_index];
+            // Clear queued before reading, so a writer updating after our
+            // read re-enqueues the slot rather than being lost.
+            slot.queued.store(0, std::memory_order_release);
+
+            const uint32_t v = claim(slot);
+            const Intent intent = copyPayload(slot);
+            slot.type = IntentType::NONE;
+            release(slot, v);
+
+            if (intent.type == IntentType::NONE || intent.type == IntentType::SUPPRESS) {
+                continue;  // Re-queued duplicate, or an annihilated NEW/cancel pair
+            }
+
+            refillTokens(tokens, last_refill_ns);
+            while (rate_per_sec_.load(std::memory_order_relaxed) != 0 && tokens < 1.0) {
+                std::this_thread::sleep_for(std::chrono::microseconds(100));
+                refillTokens(tokens, last_refill_ns);
+            }
+            tokens -= 1.0;
+
+            transmit(intent);
+
+            // Keep issuing while intents and tokens last: back-to-back calls
+            // in one wakeup give the socket layer a shot at one segment.
+            int batched = 1;
+            uint32_t next_index;
+            while (batched < BATCH_MAX &&
+                   (rate_per_sec_.load(std::memory_order_relaxed) == 0 || tokens >= 1.0) &&
+                   ringPop(next_index)) {
+                IntentSlot& next = slots_[next_index];
+                next.queued.store(0, std::memory_order_release);
+                const uint32_t nv = claim(next);
+                const Intent next_intent = copyPayload(next);
+                next.type = IntentType::NONE;
+                release(next, nv);
+                if (next_intent.type == IntentType::NONE || next_intent.type == IntentType::SUPPRESS) {
+                    continue;
+                }
+                tokens -= 1.0;
+                transmit(next_intent);
+                ++batched;
+            }
+        }
+    }
+
+    // Non-atomic field copy; caller holds the slot claimed.
+    static Intent copyPayload(const IntentSlot& slot) {
+        Intent out;
+        out.type = slot.type;
+        out.is_buy = slot.is_buy;
+        out.order_id = slot.order_id;
+        out.symbol_id = slot.symbol_id;
+        out.price = slot.price;
+        out.quantity = slot.quantity;
+        return out;
+    }
+
+    void transmit(const Intent& intent) {
+        if (connector_ == nullptr) {
+            return;
+        }
+        switch (intent.type) {
+            case IntentType::NEW:
+                connector_->sendOrder(intent.order_id, SymbolTable::instance().name(intent.symbol_id),
+                                      intent.price, intent.quantity, intent.is_buy);
+                break;
+            case IntentType::MODIFY:
+                connector_->modifyOrder(intent.order_id, intent.price, intent.quantity);
+                break;
+            case IntentType::CANCEL:
+                connector_->cancelOrder(intent.order_id);
+                break;
+            default:
+                return;
+        }
+        sent_.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    void refillTokens(double& tokens, int64_t& last_refill_ns) {
+        const uint32_t rate = rate_per_sec_.load(std::memory_order_relaxed);
+        if (rate == 0) {
+            return;
+        }
+        const int64_t now = nowNs();
+        tokens += static_cast<double>(now - last_refill_ns) * 1e-9 * rate;
+        const double cap = static_cast<double>(burst_.load(std::memory_order_relaxed));
+        if (tokens > cap) {
+            tokens = cap;
+        }
+        last_refill_ns = now;
+    }
+
+    bool pendingOnRing() const {
+        return ring_head_ != ring_tail_.load(std::memory_order_acquire);
+    }
+
+    static int64_t nowNs() {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+
+    std::unique_ptr<IntentSlot[]> slots_;
+    RingCell ring_[RING_SIZE] = {};
+    std::atomic<uint64_t> ring_tail_{0};
+    uint64_t ring_head_ = 0;
+
+    ExchangeConnector* connector_ = nullptr;
+    std::thread drain_thread_;
+    std::atomic<bool> running_{false};
+
+    std::atomic<uint32_t> rate_per_sec_{0};   // 0 = uncapped
+    std::atomic<uint32_t> burst_{64};
+
+    std::atomic<uint64_t> sent_{0};
+    std::atomic<uint64_t> coalesced_{0};
+    std::atomic<uint64_t> suppressed_{0};
+};
+
+#endif  // ORDER_EGRESS_HPP
@@ -0,0 +1,225 @@
+#ifndef ORDER_JOURNAL_HPP
+#define ORDER_JOURNAL_HPP
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+// Binary order journaling.
+//
+// The order hot path used to format a seven-field log string (with as many
+// std::to_string calls) under the order mutex on every create/cancel/modify/
+// update. Here the hot path does one memcpy of a fixed 48-byte OrderEvent
+// into a lock-free ring; a background thread drains the ring into an
+// append-only binary journal file with buffered writes. Rendering to text is
+// an offline job (scripts/render_order_journal.py), and replaying the journal
+// reconstructs order state after a crash — which the text log never could.
+
+enum class OrderEventAction : uint8_t {
+    CREATE = 0,
+    CANCEL = 1,
+    MODIFY = 2,
+    UPDATE = 3,
+};
+
+// Fixed-layout journal record. The layout is the on-disk format; bump
+// JOURNAL_VERSION if it ever changes so old files stay readable.
+struct OrderEvent {
+    uint64_t ts_ns;            // Event time, nanoseconds since epoch
+    double price;              // Limit price at event time
+    int32_t order_id;          // OrderManager id
+    int32_t quantity;          // Order quantity at event time
+    int32_t filled_quantity;   // Cumulative filled quantity
+    char symbol[12];           // NUL-padded symbol (truncated if longer)
+    uint8_t action;            // OrderEventAction
+    uint8_t status;            // Order::Status as integer
+    uint8_t is_buy;            // 1 = buy, 0 = sell
+    uint8_t pad;               // Explicit padding, always zero
+};
+
+static_assert(std::is_trivially_copyable<OrderEvent>::value, "OrderEvent must be memcpy-able");
+static_assert(sizeof(OrderEvent) == 48, "OrderEvent is the on-disk format; do not change casually");
+
+constexpr uint32_t JOURNAL_VERSION = 1;
+
+// Bounded lock-free multi-producer/single-consumer ring for OrderEvent.
+//
+// Vyukov-style: each slot carries a sequence number; producers claim a slot
+// with one CAS on the enqueue cursor, then publish by bumping the slot
+// sequence. The single consumer (the journal writer thread) needs no
+// synchronization beyond the slot sequences. Full ring = drop with counter;
+// the trading path is never allowed to block on journaling.
+template <std::size_t Capacity>
+class OrderEventRing {
+    static_assert((Capacity & (Capacity - 1)) == 0, "Capacity must be a power of two");
+
+public:
+    OrderEventRing() : enqueue_pos_(0), dequeue_pos_(0) {
+        for (std::size_t i = 0; i < Capacity; ++i) {
+            slots_[i].seq.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    bool try_push(const OrderEvent& event) {
+        std::size_t pos = enqueue_pos_.load(std::memory_order_relaxed);
+        for (;;) {
+            Slot& slot = slots_[pos & (Capacity - 1)];
+            const std::size_t seq = slot.seq.load(std::memory_order_acquire);
+            const intptr_t diff = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos);
+            if (diff == 0) {
+                if (enqueue_pos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    slot.event = event;
+                    slot.seq.store(pos + 1, std::memory_order_release);
+                    return true;
+                }
+            } else if (diff < 0) {
+                return false;  // Ring full
+            } else {
+                pos = enqueue_pos_.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    // Single consumer only.
+    bool try_pop(OrderEvent& out) {
+        const std::size_t pos = dequeue_pos_;
+        Slot& slot = slots_[pos & (Capacity - 1)];
+        const std::size_t seq = slot.seq.load(std::memory_order_acquire);
+        if (static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos + 1) < 0) {
+            return false;  // Ring empty
+        }
+        out = slot.event;
+        slot.seq.store(pos + Capacity, std::memory_order_release);
+        dequeue_pos_ = pos + 1;
+        return true;
+    }
+
+private:
+    struct Slot {
+        std::atomic<std::size_t> seq;
+        OrderEvent event;
+    };
+
+    alignas(64) Slot slots_[Capacity];
+    alignas(64) std::atomic<std::size_t> enqueue_pos_;
+    alignas(64) std::size_t dequeue_pos_;  // Consumer-private
+};
+
+class OrderJournal {
+public:
+    explicit OrderJournal(const std::string& filename)
+        : running_(true), dropped_events_(0) {
+        file_ = std::fopen(filename.c_str(), "ab");
+        if (file_ == nullptr) {
+            std::perror("OrderJournal: failed to open journal file");
+        }
+        writer_thread_ = std::thread(&OrderJournal::drainLoop, this);
+    }
+
+    ~OrderJournal() {
+        running_.store(false, std::memory_order_release);
+        if (writer_thread_.joinable()) {
+            writer_thread_.join();
+        }
+        if (file_ != nullptr) {
+            std::fclose(file_);
+        }
+    }
+
+    OrderJournal(const OrderJournal&) = delete;
+    OrderJournal& operator=(const OrderJournal&) = delete;
+
+    // Hot path: fill a fixed record and memcpy it into the ring. No string
+    // formatting, no allocation, no lock, never blocks. The symbol arrives as
+    // a C string straight out of the intern table's reverse lookup.
+    void record(OrderEventAction action, int order_id, const char* symbol,
+                double price, int quantity, int filled_quantity, uint8_t status, bool is_buy) {
+        OrderEvent event{};
+        event.ts_ns = static_cast<uint64_t>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::system_clock::now().time_since_epoch()).count());
+        event.price = price;
+        event.order_id = order_id;
+        event.quantity = quantity;
+        event.filled_quantity = filled_quantity;
+        std::size_t n = 0;
+        while (n < sizeof(event.symbol) && symbol[n] != '\0') {
+            event.symbol[n] = symbol[n];
+            ++n;
+        }
+        event.action = static_cast<uint8_t>(action);
+        event.status = status;
+        event.is_buy = is_buy ? 1 : 0;
+        if (!ring_.try_push(event)) {
+            dropped_events_.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+    uint64_t droppedEvents() const { return dropped_events_.load(std::memory_order_relaxed); }
+
+    // Replay a journal file for crash recovery or offline analysis. Returns
+    // events in write order; a short trailing record (torn final write after
+    // a crash) is silently discarded.
+    static std::vector<OrderEvent> replay(const std::string& filename) {
+        std::vector<OrderEvent> events;
+        std::FILE* f = std::fopen(filename.c_str(), "rb");
+        if (f == nullptr) {
+            return events;
+        }
+        OrderEvent event;
+        while (std::fread(&event, sizeof(OrderEvent), 1, f) == 1) {
+            events.push_back(event);
+        }
+        std::fclose(f);
+        return events;
+    }
+
+private:
+    static constexpr std::size_t RING_CAPACITY = 1 << 16;
+    static constexpr std::size_t FLUSH_BATCH = 256;
+
+    void drainLoop() {
+        OrderEvent event;
+        std::size_t since_flush = 0;
+        while (running_.load(std::memory_order_acquire) || drainOnce(event, since_flush)) {
+            if (!drainOnce(event, since_flush)) {
+                if (since_flush > 0 && file_ != nullptr) {
+                    std::fflush(file_);
+                    since_flush = 0;
+                }
+                std::this_thread::sleep_for(std::chrono::microseconds(100));
+            }
+        }
+        if (file_ != nullptr) {
+            std::fflush(file_);
+        }
+    }
+
+    bool drainOnce(OrderEvent& event, std::size_t& since_flush) {
+        if (!ring_.try_pop(event)) {
+            return false;
+        }
+        if (file_ != nullptr) {
+            std::fwrite(&event, sizeof(OrderEvent), 1, file_);
+            if (++since_flush >= FLUSH_BATCH) {
+                std::fflush(file_);
+                since_flush = 0;
+            }
+        }
+        return true;
+    }
+
+    OrderEventRing<RING_CAPACITY> ring_;
+    std::FILE* file_;
+    std::thread writer_thread_;
+    std::atomic<bool> running_;
+    std::atomic<uint64_t> dropped_events_;
+};
+
+#endif  // ORDER_JOURNAL_HPP
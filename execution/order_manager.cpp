@@ -1,22 +1,34 @@
 #include <iostream>
+#include <memory>
 #include <unordered_map>
 #include <vector>
 #include <string>
 #include <mutex>
 #include <chrono>
+#include <cstdint>
 #include "exchange_connector.h"
 #include "log_utils.h"
+#include "metrics_registry.hpp"
+#include "order_egress.hpp"
+#include "order_journal.hpp"
+#include "risk_engine.hpp"
+#include "symbol_table.hpp"
+#include "warm_start.hpp"
 
 class Order {
 public:
     enum class Status { PENDING, FILLED, CANCELED, REJECTED, PARTIALLY_FILLED };
 
-    Order(int id, const std::string& symbol, double price, int quantity, bool is_buy)
-        : order_id(id), symbol(symbol), price(price), quantity(quantity), is_buy(is_buy), status(Status::PENDING), filled_quantity(0),
+    Order() = default;
+
+    Order(int id, uint32_t symbol_id, double price, int quantity, bool is_buy)
+        : order_id(id), symbol_id(symbol_id), price(price), quantity(quantity), filled_quantity(0), is_buy(is_buy), status(Status::PENDING),
           timestamp(std::chrono::system_clock::now()) {}
 
     int getOrderId() const { return order_id; }
-    std::string getSymbol() const { return symbol; }
+    uint32_t getSymbolId() const { return symbol_id; }
+    // Cold-path reverse lookup; hot code compares symbol ids instead.
+    std::string getSymbol() const { return SymbolTable::instance().name(symbol_id); }
     double getPrice() const { return price; }
     int getQuantity() const { return quantity; }
     int getFilledQuantity() const { return filled_quantity; }
@@ -34,111 +46,542 @@ public:
     auto getTimestamp() const { return timestamp; }
 
 private:
-    int order_id;
-    std::string symbol;
-    double price;
-    int quantity;
-    int filled_quantity;
-    bool is_buy;
-    Status status;
+    friend class OrderManager;
+
+    int order_id = 0;
+    uint32_t symbol_id = 0;
+    double price = 0.0;
+    int quantity = 0;
+    int filled_quantity = 0;
+    bool is_buy = false;
+    Status status = Status::PENDING;
     std::chrono::time_point<std::chrono::system_clock> timestamp;
+
+    // Intrusive index links, maintained by OrderManager. Links are slot
+    // indexes into the slab (not pointers) so they survive nothing — the slab
+    // is fixed-capacity and never reallocates. -1 terminates a list.
+    int32_t next_in_status = -1;
+    int32_t prev_in_status = -1;
+    int32_t next_in_symbol = -1;
+    int32_t prev_in_symbol = -1;
+    bool slot_in_use = false;
 };
 
+// Pooled order store.
+//
+// Orders live in a pre-sized slab of Order records; creating an order is a
+// free-list pop plus field writes, never an allocation. Each live record is
+// threaded onto two intrusive doubly-linked lists: one per status (so
+// getActiveOrders and fill processing never scan the whole book) and one per
+// symbol (so a mass cancel walks exactly the orders it will touch). All index
+// maintenance is O(1) link surgery.
+//
+// Order ids encode (generation << SLOT_BITS) | slot, so id-to-record lookup
+// is two shifts and a compare — a stale id from a recycled slot fails the
+// generation check instead of silently hitting the wrong order. Slots are
+// recycled when an order goes CANCELED/REJECTED; FILLED orders stay on the
+// filled list for downstream P&L until clearFilledOrders() releases them.
+//
+// Concurrency: the store is split into NUM_SHARDS independent shards, each
+// with its own slab, free list, indexes, and mutex. Orders land on the shard
+// chosen by their symbol hash, so the execution-report reader and strategy
+// threads working different names never touch the same lock, and a burst of
+// auction fills on one symbol only serializes that shard. The global slot
+// index carries the shard in its high bits, so every per-id operation goes
+// straight to the owning shard without any shared lookup structure.
 class OrderManager {
 public:
-    OrderManager() = default;
+    static constexpr int SHARD_BITS = 4;
+    static constexpr int NUM_SHARDS = 1 << SHARD_BITS;          // 16 shards
+    static constexpr int LOCAL_BITS = 13;
+    static constexpr int SHARD_CAPACITY = 1 << LOCAL_BITS;      // 8192 slots each
+    static constexpr int SLOT_BITS = SHARD_BITS + LOCAL_BITS;   // 2^17 slots total
+    static constexpr int SLOT_MASK = (1 << SLOT_BITS) - 1;
+    static constexpr int LOCAL_MASK = SHARD_CAPACITY - 1;
 
-    int createOrder(const std::string& symbol, double price, int quantity, bool is_buy) {
-        std::lock_guard<std::mutex> lock(mutex_);
-        int order_id = ++order_id_counter;
-        orders_.emplace(order_id, Order(order_id, symbol, price, quantity, is_buy));
-        logOrder("CREATE", order_id);
-        exchangeConnector.sendOrder(order_id, symbol, price, quantity, is_buy);
+    OrderManager() {
+        egress_.attach(&exchangeConnector);
+        egress_.start();
+        for (auto& shard : shards_) {
+            shard.slab.resize(SHARD_CAPACITY);
+            shard.generations.assign(SHARD_CAPACITY, 0);
+            shard.free_list.reserve(SHARD_CAPACITY);
+            // Push in reverse so the first orders come from the low slots.
+            for (int slot = SHARD_CAPACITY - 1; slot >= 0; --slot) {
+                shard.free_list.push_back(slot);
+            }
+            for (auto& head : shard.status_head) {
+                head = -1;
+            }
+        }
+    }
+
+    // Hot-path entry: the symbol is already an interned id. No string is
+    // copied, hashed, or compared anywhere below this line.
+    int createOrder(uint32_t symbol_id, double price, int quantity, bool is_buy) {
+        // Pre-trade gate before any slot is touched: a few relaxed loads and
+        // compares against the symbol's cache-aligned limit slot. On ACCEPT
+        // the quantity/notional are already reserved.
+        const RiskVerdict verdict = risk_engine_.checkNewOrder(symbol_id, price, quantity, is_buy);
+        if (verdict != RiskVerdict::ACCEPT) {
+            LOG(WARNING, "[ORDER MANAGER] Order rejected by risk check (", riskVerdictName(verdict),
+                "). Symbol id: ", symbol_id, ", quantity: ", quantity);
+            orders_rejected_.inc();
+            return -1;
+        }
+
+        Shard& shard = shardForSymbol(symbol_id);
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        if (shard.free_list.empty()) {
+            LOG(WARNING, "[ORDER MANAGER] Order shard exhausted. Order rejected.");
+            risk_engine_.onOrderClosed(symbol_id, price, quantity, is_buy);  // Hand the reservation back
+            return -1;
+        }
+        int slot = shard.free_list.back();
+        shard.free_list.pop_back();
+
+        int order_id = makeOrderId(shard, slot);
+        Order& order = shard.slab[slot];
+        order = Order(order_id, symbol_id, price, quantity, is_buy);
+        order.slot_in_use = true;
+        linkStatus(shard, slot, Order::Status::PENDING);
+        linkSymbol(shard, slot, symbol_id);
+
+        journalOrder(OrderEventAction::CREATE, order);
+        // Wire traffic goes through the coalescing egress stage, not the
+        // connector directly; only the latest intent per order is ever sent.
+        egress_.submitNew(order_id, symbol_id, price, quantity, is_buy);
+        orders_created_.inc();
         return order_id;
     }
 
+    // Cold compatibility entry: interns on the way in.
+    int createOrder(const std::string& symbol, double price, int quantity, bool is_buy) {
+        return createOrder(SymbolTable::instance().intern(symbol), price, quantity, is_buy);
+    }
+
     void cancelOrder(int order_id) {
-        std::lock_guard<std::mutex> lock(mutex_);
-        if (orders_.find(order_id) != orders_.end() && orders_[order_id].getStatus() == Order::Status::PENDING) {
-            orders_[order_id].setStatus(Order::Status::CANCELED);
-            logOrder("CANCEL", order_id);
-            exchangeConnector.cancelOrder(order_id);
+        Shard& shard = shardForId(order_id);
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        Order* order = lookup(shard, order_id);
+        if (order != nullptr && order->getStatus() == Order::Status::PENDING) {
+            moveToStatus(shard, localSlotOf(order_id), Order::Status::CANCELED);
+            journalOrder(OrderEventAction::CANCEL, *order);
+            egress_.submitCancel(order_id);
+            risk_engine_.onOrderClosed(order->getSymbolId(), order->getPrice(),
+                                       order->getQuantity() - order->getFilledQuantity(), order->isBuy());
+            releaseSlot(shard, localSlotOf(order_id));
         } else {
-            log_utils::log("[ORDER MANAGER] Order cancel failed. Order ID: " + std::to_string(order_id) + " is not pending.");
+            LOG(WARNING, "[ORDER MANAGER] Order cancel failed. Order ID: ", order_id, " is not pending.");
         }
     }
 
+    // Mass cancel: all of a symbol's orders live on one shard, so this takes
+    // one shard lock and walks only the symbol's own intrusive list.
+    int cancelAllForSymbol(uint32_t symbol_id) {
+        Shard& shard = shardForSymbol(symbol_id);
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        auto it = shard.symbol_head.find(symbol_id);
+        if (it == shard.symbol_head.end()) {
+            return 0;
+        }
+        int canceled = 0;
+        int slot = it->second;
+        while (slot != -1) {
+            int next = shard.slab[slot].next_in_symbol;  // Grab before we unlink
+            Order& order = shard.slab[slot];
+            if (order.getStatus() == Order::Status::PENDING ||
+                order.getStatus() == Order::Status::PARTIALLY_FILLED) {
+                moveToStatus(shard, slot, Order::Status::CANCELED);
+                journalOrder(OrderEventAction::CANCEL, order);
+                egress_.submitCancel(order.getOrderId());
+                risk_engine_.onOrderClosed(order.getSymbolId(), order.getPrice(),
+                                           order.getQuantity() - order.getFilledQuantity(), order.isBuy());
+                releaseSlot(shard, slot);
+                ++canceled;
+            }
+            slot = next;
+        }
+        return canceled;
+    }
+
+    int cancelAllForSymbol(const std::string& symbol) {
+        const uint32_t symbol_id = SymbolTable::instance().lookup(symbol);
+        return symbol_id == SymbolTable::INVALID_SYMBOL ? 0 : cancelAllForSymbol(symbol_id);
+    }
+
     void modifyOrder(int order_id, double new_price, int new_quantity) {
-        std::lock_guard<std::mutex> lock(mutex_);
-        if (orders_.find(order_id) != orders_.end() && orders_[order_id].getStatus() == Order::Status::PENDING) {
-            Order& order = orders_.at(order_id);
-            order = Order(order_id, order.getSymbol(), new_price, new_quantity, order.isBuy());
-            logOrder("MODIFY", order_id);
-            exchangeConnector.modifyOrder(order_id, new_price, new_quantity);
+        Shard& shard = shardForId(order_id);
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        Order* order = lookup(shard, order_id);
+        if (order != nullptr && order->getStatus() == Order::Status::PENDING) {
+            risk_engine_.onOrderModified(order->getSymbolId(),
+                                         order->getPrice(), order->getQuantity() - order->getFilledQuantity(),
+                                         new_price, new_quantity - order->getFilledQuantity(), order->isBuy());
+            // Update in place — the slot keeps its id and index links.
+            order->price = new_price;
+            order->quantity = new_quantity;
+            order->timestamp = std::chrono::system_clock::now();
+            journalOrder(OrderEventAction::MODIFY, *order);
+            egress_.submitModify(order_id, new_price, new_quantity);
         } else {
-            log_utils::log("[ORDER MANAGER] Order modification failed. Order ID: " + std::to_string(order_id) + " is not pending.");
+            LOG(WARNING, "[ORDER MANAGER] Order modification failed. Order ID: ", order_id, " is not pending.");
         }
     }
 
     void processOrderUpdate(int order_id, Order::Status status, int filled_qty = 0) {
-        std::lock_guard<std::mutex> lock(mutex_);
-        if (orders_.find(order_id) != orders_.end()) {
-            orders_[order_id].setStatus(status);
-            if (filled_qty > 0) {
-                orders_[order_id].updateFilledQuantity(filled_qty);
-            }
-            logOrder("UPDATE", order_id);
+        Shard& shard = shardForId(order_id);
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        Order* order = lookup(shard, order_id);
+        if (order == nullptr) {
+            LOG(WARNING, "[ORDER MANAGER] Order update failed. Order ID: ", order_id, " not found.");
+            return;
+        }
+        int slot = localSlotOf(order_id);
+        if (filled_qty > 0) {
+            order->updateFilledQuantity(filled_qty);
+            moveToStatus(shard, slot, order->getStatus());
+            // Fill converts the risk reservation into position, at the price
+            // it was reserved at so the exposure counters stay balanced.
+            risk_engine_.onFill(order->getSymbolId(), order->getPrice(), filled_qty, order->isBuy());
         } else {
-            log_utils::log("[ORDER MANAGER] Order update failed. Order ID: " + std::to_string(order_id) + " not found.");
+            moveToStatus(shard, slot, status);
+        }
+        journalOrder(OrderEventAction::UPDATE, *order);
+        if (order->getStatus() == Order::Status::CANCELED ||
+            order->getStatus() == Order::Status::REJECTED) {
+            risk_engine_.onOrderClosed(order->getSymbolId(), order->getPrice(),
+                                       order->getQuantity() - order->getFilledQuantity(), order->isBuy());
+            releaseSlot(shard, slot);
         }
     }
 
+    // Snapshot queries lock shards one at a time — a consistent point-in-time
+    // view across shards is not promised (and reporting does not need one),
+    // in exchange for never stalling writers on more than one shard.
     std::vector<Order> getActiveOrders() {
-        std::lock_guard<std::mutex> lock(mutex_);
         std::vector<Order> active_orders;
-        for (const auto& [order_id, order] : orders_) {
-            if (order.getStatus() == Order::Status::PENDING || order.getStatus() == Order::Status::PARTIALLY_FILLED) {
-                active_orders.push_back(order);
-            }
+        for (auto& shard : shards_) {
+            std::lock_guard<std::mutex> lock(shard.mutex);
+            collectStatusList(shard, shard.status_head[statusIndex(Order::Status::PENDING)], active_orders);
+            collectStatusList(shard, shard.status_head[statusIndex(Order::Status::PARTIALLY_FILLED)], active_orders);
         }
         return active_orders;
     }
 
     std::vector<Order> getFilledOrders() {
-        std::lock_guard<std::mutex> lock(mutex_);
         std::vector<Order> filled_orders;
-        for (const auto& [order_id, order] : orders_) {
-            if (order.getStatus() == Order::Status::FILLED) {
-                filled_orders.push_back(order);
-            }
+        for (auto& shard : shards_) {
+            std::lock_guard<std::mutex> lock(shard.mutex);
+            collectStatusList(shard, shard.status_head[statusIndex(Order::Status::FILLED)], filled_orders);
         }
         return filled_orders;
     }
 
+    // Release filled orders back to the free list once downstream consumers
+    // (P&L, reporting) have drained them. Keeps the slabs bounded over a day.
+    void clearFilledOrders() {
+        for (auto& shard : shards_) {
+            std::lock_guard<std::mutex> lock(shard.mutex);
+            int slot = shard.status_head[statusIndex(Order::Status::FILLED)];
+            while (slot != -1) {
+                int next = shard.slab[slot].next_in_status;
+                releaseSlot(shard, slot);
+                slot = next;
+            }
+        }
+    }
+
     void printOrderSummary() {
-        std::lock_guard<std::mutex> lock(mutex_);
         log_utils::log("[ORDER MANAGER] Order Summary:");
-        for (const auto& [order_id, order] : orders_) {
-            logOrder("SUMMARY", order_id);
+        for (auto& shard : shards_) {
+            std::lock_guard<std::mutex> lock(shard.mutex);
+            for (int head : shard.status_head) {
+                for (int slot = head; slot != -1; slot = shard.slab[slot].next_in_status) {
+                    logOrder("SUMMARY", shard.slab[slot]);
+                }
+            }
+        }
+    }
+
+    // Warm-start: dump every shard's slab and generation array to a snapshot
+    // file, shard by shard under each shard's own lock. Orders are trivially
+    // copyable (the symbol is an interned id), so a shard section is one
+    // memcpy of the slab.
+    bool saveSnapshot(const std::string& path) {
+        static_assert(std::is_trivially_copyable<Order>::value,
+                      "Order must stay memcpy-able for warm-start snapshots");
+        SnapshotWriter writer(path);
+        for (int s = 0; s < NUM_SHARDS; ++s) {
+            Shard& shard = shards_[s];
+            std::lock_guard<std::mutex> lock(shard.mutex);
+            writer.writeArray(SNAP_SHARD_BASE + s * 2, shard.slab.data(), shard.slab.size());
+            writer.writeArray(SNAP_SHARD_BASE + s * 2 + 1, shard.generations.data(),
+                              shard.generations.size());
         }
+        return writer.close();
     }
 
+    // Warm-start restore: memcpy the slabs back, rebuild the derived indexes
+    // (free lists, status lists, symbol lists) from the in-use flags, then
+    // re-apply journal events newer than the snapshot so nothing between the
+    // last snapshot and the crash is lost. No wire traffic, no journaling —
+    // the journal already has these events.
+    bool restoreSnapshot(const std::string& path,
+                         const std::string& journal_path = "order_journal.bin") {
+        SnapshotReader reader;
+        if (!reader.open(path)) {
+            return false;
+        }
+        for (int s = 0; s < NUM_SHARDS; ++s) {
+            Shard& shard = shards_[s];
+            std::lock_guard<std::mutex> lock(shard.mutex);
+            if (!reader.readArray(SNAP_SHARD_BASE + s * 2, shard.slab.data(), shard.slab.size()) ||
+                !reader.readArray(SNAP_SHARD_BASE + s * 2 + 1, shard.generations.data(),
+                                  shard.generations.size())) {
+                return false;
+            }
+            rebuildIndexes(shard);
+        }
+        // Journal delta: everything recorded after the snapshot timestamp.
+        int replayed = 0;
+        for (const OrderEvent& event : OrderJournal::replay(journal_path)) {
+            if (event.ts_ns > reader.snapshotTsNs()) {
+                applyJournalEvent(event);
+                ++replayed;
+            }
+        }
+        LOG(INFO, "[ORDER MANAGER] Warm start: snapshot restored, ", replayed,
+            " journal events re-applied.");
+        return true;
+    }
+
+    // Control-channel access to the risk engine (limit loads, clamp-downs).
+    RiskEngine& riskEngine() { return risk_engine_; }
+
+    // Egress stage access (venue rate limits, coalescing stats).
+    OrderEgress& egress() { return egress_; }
+
     bool isOrderActive(int order_id) {
-        std::lock_guard<std::mutex> lock(mutex_);
-        if (orders_.find(order_id) != orders_.end()) {
-            return orders_[order_id].getStatus() == Order::Status::PENDING || orders_[order_id].getStatus() == Order::Status::PARTIALLY_FILLED;
+        Shard& shard = shardForId(order_id);
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        const Order* order = lookup(shard, order_id);
+        if (order != nullptr) {
+            return order->getStatus() == Order::Status::PENDING || order->getStatus() == Order::Status::PARTIALLY_FILLED;
         }
         return false;
     }
 
 private:
-    std::unordered_map<int, Order> orders_;
-    std::mutex mutex_;
-    int order_id_counter = 0;
+    // One shard = one independent order store. Padded to its own cache lines
+    // so neighbouring shard mutexes never false-share.
+    struct alignas(64) Shard {
+        std::vector<Order> slab;
+        std::vector<uint32_t> generations;
+        std::vector<int> free_list;
+        int status_head[5];
+        std::unordered_map<uint32_t, int> symbol_head;
+        std::mutex mutex;
+    };
+
+    Shard shards_[NUM_SHARDS];
     ExchangeConnector exchangeConnector;
+    OrderJournal journal_{"order_journal.bin"};
+    RiskEngine risk_engine_;
+    OrderEgress egress_;
+    // Registry counters: wait-free per-thread increments, aggregated and
+    // published to the dashboard off the hot path (metrics_registry.hpp).
+    Counter orders_created_{"om.orders_created"};
+    Counter orders_rejected_{"om.orders_rejected"};
+
+    // Hot-path journaling: one fixed-size binary record into the lock-free
+    // ring, drained to disk off-thread. Replaces the per-operation formatted
+    // log line; render the journal with scripts/render_order_journal.py.
+    void journalOrder(OrderEventAction action, const Order& order) {
+        journal_.record(action, order.getOrderId(),
+                        SymbolTable::instance().name(order.getSymbolId()), order.getPrice(),
+                        order.getQuantity(), order.getFilledQuantity(),
+                        static_cast<uint8_t>(order.getStatus()), order.isBuy());
+    }
+
+    // Snapshot section ids: two sections per shard (slab, generations).
+    static constexpr uint32_t SNAP_SHARD_BASE = 100;
 
-    void logOrder(const std::string& action, int order_id) {
-        const Order& order = orders_.at(order_id);
+    // Derive free list, status lists and symbol lists from restored slabs.
+    // List order is not part of the contract, only membership.
+    void rebuildIndexes(Shard& shard) {
+        shard.free_list.clear();
+        shard.symbol_head.clear();
+        for (auto& head : shard.status_head) {
+            head = -1;
+        }
+        for (int slot = SHARD_CAPACITY - 1; slot >= 0; --slot) {
+            if (!shard.slab[slot].slot_in_use) {
+                shard.free_list.push_back(slot);
+            }
+        }
+        for (int slot = 0; slot < SHARD_CAPACITY; ++slot) {
+            if (shard.slab[slot].slot_in_use) {
+                shard.slab[slot].prev_in_status = shard.slab[slot].next_in_status = -1;
+                shard.slab[slot].prev_in_symbol = shard.slab[slot].next_in_symbol = -1;
+                linkStatus(shard, slot, shard.slab[slot].status);
+                linkSymbol(shard, slot, shard.slab[slot].symbol_id);
+            }
+        }
+    }
+
+    // Re-apply one post-snapshot journal event to restored state. Pure state
+    // surgery: no exchange traffic, no re-journaling, no risk reservation —
+    // the event already happened.
+    void applyJournalEvent(const OrderEvent& event) {
+        Shard& shard = shardForId(event.order_id);
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        const auto action = static_cast<OrderEventAction>(event.action);
+        if (action == OrderEventAction::CREATE) {
+            const int slot = localSlotOf(event.order_id);
+            if (shard.slab[slot].slot_in_use) {
+                return;  // Snapshot already carries it
+            }
+            shard.generations[slot] = static_cast<uint32_t>(event.order_id) >> SLOT_BITS;
+            Order& order = shard.slab[slot];
+            order = Order(event.order_id, SymbolTable::instance().intern(event.symbol),
+                          event.price, event.quantity, event.is_buy != 0);
+            order.slot_in_use = true;
+            for (std::size_t i = 0; i < shard.free_list.size(); ++i) {
+                if (shard.free_list[i] == slot) {
+                    shard.free_list[i] = shard.free_list.back();
+                    shard.free_list.pop_back();
+                    break;
+                }
+            }
+            linkStatus(shard, slot, Order::Status::PENDING);
+            linkSymbol(shard, slot, order.symbol_id);
+            return;
+        }
+        Order* order = lookup(shard, event.order_id);
+        if (order == nullptr) {
+            return;  // Event for an order the snapshot+delta no longer knows
+        }
+        const int slot = localSlotOf(event.order_id);
+        switch (action) {
+            case OrderEventAction::MODIFY:
+                order->price = event.price;
+                order->quantity = event.quantity;
+                break;
+            case OrderEventAction::UPDATE:
+                order->filled_quantity = event.filled_quantity;
+                moveToStatus(shard, slot, static_cast<Order::Status>(event.status));
+                if (order->status == Order::Status::CANCELED ||
+                    order->status == Order::Status::REJECTED) {
+                    releaseSlot(shard, slot);
+                }
+                break;
+            case OrderEventAction::CANCEL:
+                moveToStatus(shard, slot, Order::Status::CANCELED);
+                releaseSlot(shard, slot);
+                break;
+            default:
+                break;
+        }
+    }
+
+    static int statusIndex(Order::Status s) { return static_cast<int>(s); }
+    static int localSlotOf(int order_id) { return order_id & LOCAL_MASK; }
+    static int shardIndexOf(int order_id) { return (order_id >> LOCAL_BITS) & (NUM_SHARDS - 1); }
+
+    Shard& shardForId(int order_id) { return shards_[shardIndexOf(order_id)]; }
+
+    // Dense ids spread round-robin over the shards — no hashing at all.
+    Shard& shardForSymbol(uint32_t symbol_id) {
+        return shards_[symbol_id & (NUM_SHARDS - 1)];
+    }
+
+    int shardIndex(const Shard& shard) const { return static_cast<int>(&shard - shards_); }
+
+    int makeOrderId(const Shard& shard, int slot) const {
+        uint32_t global_slot = (static_cast<uint32_t>(shardIndex(shard)) << LOCAL_BITS) | static_cast<uint32_t>(slot);
+        return static_cast<int>((shard.generations[slot] << SLOT_BITS) | global_slot);
+    }
+
+    // O(1) id-to-record: decode the slot, then verify the generation so a
+    // stale id from a recycled slot is rejected instead of aliased.
+    Order* lookup(Shard& shard, int order_id) {
+        int slot = localSlotOf(order_id);
+        if (!shard.slab[slot].slot_in_use || makeOrderId(shard, slot) != order_id) {
+            return nullptr;
+        }
+        return &shard.slab[slot];
+    }
+
+    void linkStatus(Shard& shard, int slot, Order::Status status) {
+        int idx = statusIndex(status);
+        shard.slab[slot].status = status;
+        shard.slab[slot].prev_in_status = -1;
+        shard.slab[slot].next_in_status = shard.status_head[idx];
+        if (shard.status_head[idx] != -1) {
+            shard.slab[shard.status_head[idx]].prev_in_status = slot;
+        }
+        shard.status_head[idx] = slot;
+    }
+
+    void unlinkStatus(Shard& shard, int slot) {
+        Order& order = shard.slab[slot];
+        if (order.prev_in_status != -1) {
+            shard.slab[order.prev_in_status].next_in_status = order.next_in_status;
+        } else {
+            shard.status_head[statusIndex(order.status)] = order.next_in_status;
+        }
+        if (order.next_in_status != -1) {
+            shard.slab[order.next_in_status].prev_in_status = order.prev_in_status;
+        }
+        order.prev_in_status = order.next_in_status = -1;
+    }
+
+    void moveToStatus(Shard& shard, int slot, Order::Status status) {
+        unlinkStatus(shard, slot);
+        linkStatus(shard, slot, status);
+    }
+
+    void linkSymbol(Shard& shard, int slot, uint32_t symbol_id) {
+        // The map only allocates the first time a symbol is seen; after that
+        // re-linking is pure pointer surgery on the existing bucket.
+        auto [it, inserted] = shard.symbol_head.try_emplace(symbol_id, -1);
+        shard.slab[slot].prev_in_symbol = -1;
+        shard.slab[slot].next_in_symbol = it->second;
+        if (it->second != -1) {
+            shard.slab[it->second].prev_in_symbol = slot;
+        }
+        it->second = slot;
+    }
+
+    void unlinkSymbol(Shard& shard, int slot) {
+        Order& order = shard.slab[slot];
+        if (order.prev_in_symbol != -1) {
+            shard.slab[order.prev_in_symbol].next_in_symbol = order.next_in_symbol;
+        } else {
+            shard.symbol_head[order.symbol_id] = order.next_in_symbol;
+        }
+        if (order.next_in_symbol != -1) {
+            shard.slab[order.next_in_symbol].prev_in_symbol = order.prev_in_symbol;
+        }
+        order.prev_in_symbol = order.next_in_symbol = -1;
+    }
+
+    void releaseSlot(Shard& shard, int slot) {
+        unlinkStatus(shard, slot);
+        unlinkSymbol(shard, slot);
+        shard.slab[slot].slot_in_use = false;
+        shard.generations[slot]++;  // Invalidate any outstanding ids for this slot
+        shard.free_list.push_back(slot);
+    }
+
+    void collectStatusList(Shard& shard, int head, std::vector<Order>& out) {
+        for (int slot = head; slot != -1; slot = shard.slab[slot].next_in_status) {
+            out.push_back(shard.slab[slot]);
+        }
+    }
+
+    void logOrder(const std::string& action, const Order& order) {
         std::string status_str;
         switch (order.getStatus()) {
             case Order::Status::PENDING: status_str = "PENDING"; break;
@@ -148,7 +591,7 @@ private:
             case Order::Status::PARTIALLY_FILLED: status_str = "PARTIALLY FILLED"; break;
         }
         log_utils::log("[ORDER MANAGER] Action: " + action +
-                        ", Order ID: " + std::to_string(order_id) +
+                        ", Order ID: " + std::to_string(order.getOrderId()) +
                         ", Symbol: " + order.getSymbol() +
                         ", Price: " + std::to_string(order.getPrice()) +
                         ", Quantity: " + std::to_string(order.getQuantity()) +
@@ -170,7 +613,27 @@ int main() {
     orderManager.processOrderUpdate(order1, Order::Status::FILLED, 50);
 
     orderManager.cancelOrder(order2);
+    orderManager.createOrder("AAPL", 150.75, 200, true);
+    orderManager.cancelAllForSymbol("AAPL");
+
+    // Pre-trade risk: clamp AAPL and show an oversized order bouncing.
+    orderManager.riskEngine().setSymbolLimits(SymbolTable::instance().intern("AAPL"),
+                                              500, 1000, RiskEngine::UNLIMITED, INT32_MAX);
+    int rejected = orderManager.createOrder("AAPL", 150.0, 10000, true);
+    std::cout << "Oversized AAPL order id (expect -1): " << rejected << std::endl;
+
     orderManager.printOrderSummary();
 
+    // Warm start: snapshot the book, restore into a fresh manager (heap —
+    // the embedded journal ring makes a manager several MB), and confirm
+    // the surviving orders came back.
+    orderManager.saveSnapshot("order_state.snap");
+    auto restored = std::make_unique<OrderManager>();
+    if (restored->restoreSnapshot("order_state.snap")) {
+        std::cout << "Warm start: " << restored->getFilledOrders().size()
+                  << " filled and " << restored->getActiveOrders().size()
+                  << " active orders restored." << std::endl;
+    }
+
     return 0;
-}
\ No newline at end of file
+}
@@ -0,0 +1,235 @@
+#ifndef RISK_ENGINE_HPP
+#define RISK_ENGINE_HPP
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include "symbol_table.hpp"
+
+// Native pre-trade risk engine.
+//
+// The Python risk layer (execution/risk_manager.py, risk_management/limits.py)
+// stays the system of record for limit policy, but a Python round-trip per
+// order is not a latency option. This engine keeps the enforceable subset of
+// that state — per-symbol position, open-order exposure, max order size and
+// order-rate caps, plus account-wide notional — in fixed cache-aligned slots
+// indexed directly by interned symbol id. A pre-trade check is a handful of
+// relaxed atomic loads and branch-predictable integer compares, done inline
+// in OrderManager::createOrder; no locks, no allocation, no map lookups.
+//
+// Limits are plain atomics, so the control path (config reload, risk desk
+// clamp-down) updates them lock-free while the hot path keeps reading —
+// a torn view across two limit fields only means one order is judged by a
+// mix of old and new limits, which is acceptable for pre-trade gating.
+//
+// Exposure counters are maintained incrementally: createOrder reserves the
+// order's quantity and notional, fills convert reservation into position,
+// cancels and rejects hand the unfilled remainder back. Notional is tracked
+// in integer price ticks (1/10000 currency unit) so the counters stay exact
+// under concurrent fetch_add.
+
+// Fixed-point notional: price in ticks times quantity.
+constexpr int64_t RISK_PRICE_SCALE = 10000;
+
+inline int64_t risk_notional_ticks(double price, int quantity) {
+    return static_cast<int64_t>(price * RISK_PRICE_SCALE + 0.5) * quantity;
+}
+
+// Why an order was refused; ACCEPT is zero so the hot path can branch on it.
+enum class RiskVerdict : uint8_t {
+    ACCEPT = 0,
+    ORDER_TOO_LARGE,     // quantity above the symbol's max order size
+    POSITION_LIMIT,      // would push |position + open same-side qty| over cap
+    NOTIONAL_LIMIT,      // symbol or account open-notional cap hit
+    RATE_LIMIT,          // too many orders on this symbol in the current second
+};
+
+inline const char* riskVerdictName(RiskVerdict v) {
+    switch (v) {
+        case RiskVerdict::ACCEPT: return "ACCEPT";
+        case RiskVerdict::ORDER_TOO_LARGE: return "ORDER_TOO_LARGE";
+        case RiskVerdict::POSITION_LIMIT: return "POSITION_LIMIT";
+        case RiskVerdict::NOTIONAL_LIMIT: return "NOTIONAL_LIMIT";
+        case RiskVerdict::RATE_LIMIT: return "RATE_LIMIT";
+    }
+    return "UNKNOWN";
+}
+
+class RiskEngine {
+public:
+    static constexpr int64_t UNLIMITED = INT64_MAX;
+
+    RiskEngine() = default;
+
+    // ---- Hot path -------------------------------------------------------
+
+    // Pre-trade gate. On ACCEPT the order's quantity and notional are already
+    // reserved against the limits, so a concurrent burst cannot overshoot by
+    // more than the orders that individually passed.
+    RiskVerdict checkNewOrder(uint32_t symbol_id, double price, int quantity, bool is_buy) {
+        SymbolSlot& slot = symbols_[symbol_id & (SymbolTable::MAX_SYMBOLS - 1)];
+
+        if (quantity > slot.max_order_size.load(std::memory_order_relaxed)) {
+            return RiskVerdict::ORDER_TOO_LARGE;
+        }
+
+        // Worst-case position if every open same-side order (plus this one)
+        // fills: current position plus the directional open reservation.
+        const int64_t max_position = slot.max_position.load(std::memory_order_relaxed);
+        if (max_position != UNLIMITED) {
+            const int64_t position = slot.position.load(std::memory_order_relaxed);
+            const int64_t open_dir = is_buy ? slot.open_buy_qty.load(std::memory_order_relaxed) + quantity
+                                            : -(slot.open_sell_qty.load(std::memory_order_relaxed) + quantity);
+            const int64_t worst = position + open_dir;
+            if (worst > max_position || worst < -max_position) {
+                return RiskVerdict::POSITION_LIMIT;
+            }
+        }
+
+        const int64_t notional = risk_notional_ticks(price, quantity);
+        if (slot.open_notional.load(std::memory_order_relaxed) + notional >
+            slot.max_open_notional.load(std::memory_order_relaxed)) {
+            return RiskVerdict::NOTIONAL_LIMIT;
+        }
+        if (account_open_notional_.load(std::memory_order_relaxed) + notional >
+            account_max_open_notional_.load(std::memory_order_relaxed)) {
+            return RiskVerdict::NOTIONAL_LIMIT;
+        }
+
+        if (!passRateLimit(slot)) {
+            return RiskVerdict::RATE_LIMIT;
+        }
+
+        // Reserve. Relaxed is fine: the counters are sums, not synchronization.
+        if (is_buy) {
+            slot.open_buy_qty.fetch_add(quantity, std::memory_order_relaxed);
+        } else {
+            slot.open_sell_qty.fetch_add(quantity, std::memory_order_relaxed);
+        }
+        slot.open_notional.fetch_add(notional, std::memory_order_relaxed);
+        account_open_notional_.fetch_add(notional, std::memory_order_relaxed);
+        return RiskVerdict::ACCEPT;
+    }
+
+    // A fill converts reservation into position.
+    void onFill(uint32_t symbol_id, double price, int filled_qty, bool is_buy) {
+        SymbolSlot& slot = symbols_[symbol_id & (SymbolTable::MAX_SYMBOLS - 1)];
+        const int64_t notional = risk_notional_ticks(price, filled_qty);
+        if (is_buy) {
+            slot.position.fetch_add(filled_qty, std::memory_order_relaxed);
+            slot.open_buy_qty.fetch_sub(filled_qty, std::memory_order_relaxed);
+        } else {
+            slot.position.fetch_sub(filled_qty, std::memory_order_relaxed);
+            slot.open_sell_qty.fetch_sub(filled_qty, std::memory_order_relaxed);
+        }
+        slot.open_notional.fetch_sub(notional, std::memory_order_relaxed);
+        account_open_notional_.fetch_sub(notional, std::memory_order_relaxed);
+    }
+
+    // Cancel/reject hands the unfilled remainder of the reservation back.
+    void onOrderClosed(uint32_t symbol_id, double price, int remaining_qty, bool is_buy) {
+        if (remaining_qty <= 0) {
+            return;
+        }
+        SymbolSlot& slot = symbols_[symbol_id & (SymbolTable::MAX_SYMBOLS - 1)];
+        const int64_t notional = risk_notional_ticks(price, remaining_qty);
+        if (is_buy) {
+            slot.open_buy_qty.fetch_sub(remaining_qty, std::memory_order_relaxed);
+        } else {
+            slot.open_sell_qty.fetch_sub(remaining_qty, std::memory_order_relaxed);
+        }
+        slot.open_notional.fetch_sub(notional, std::memory_order_relaxed);
+        account_open_notional_.fetch_sub(notional, std::memory_order_relaxed);
+    }
+
+    // A modify re-prices the open reservation; quantity deltas flow through
+    // the same reserve/release counters the create and cancel paths use.
+    void onOrderModified(uint32_t symbol_id, double old_price, int old_remaining,
+                         double new_price, int new_remaining, bool is_buy) {
+        onOrderClosed(symbol_id, old_price, old_remaining, is_buy);
+        if (new_remaining > 0) {
+            SymbolSlot& slot = symbols_[symbol_id & (SymbolTable::MAX_SYMBOLS - 1)];
+            const int64_t notional = risk_notional_ticks(new_price, new_remaining);
+            if (is_buy) {
+                slot.open_buy_qty.fetch_add(new_remaining, std::memory_order_relaxed);
+            } else {
+                slot.open_sell_qty.fetch_add(new_remaining, std::memory_order_relaxed);
+            }
+            slot.open_notional.fetch_add(notional, std::memory_order_relaxed);
+            account_open_notional_.fetch_add(notional, std::memory_order_relaxed);
+        }
+    }
+
+    // ---- Control path (lock-free limit updates) -------------------------
+
+    void setSymbolLimits(uint32_t symbol_id, int32_t max_order_size, int64_t max_position,
+                         int64_t max_open_notional, int32_t max_orders_per_sec) {
+        SymbolSlot& slot = symbols_[symbol_id & (SymbolTable::MAX_SYMBOLS - 1)];
+        slot.max_order_size.store(max_order_size, std::memory_order_relaxed);
+        slot.max_position.store(max_position, std::memory_order_relaxed);
+        slot.max_open_notional.store(max_open_notional, std::memory_order_relaxed);
+        slot.max_orders_per_sec.store(max_orders_per_sec, std::memory_order_relaxed);
+    }
+
+    void setAccountMaxOpenNotional(int64_t max_open_notional) {
+        account_max_open_notional_.store(max_open_notional, std::memory_order_relaxed);
+    }
+
+    // ---- Introspection (reporting / tests) ------------------------------
+
+    int64_t position(uint32_t symbol_id) const {
+        return symbols_[symbol_id & (SymbolTable::MAX_SYMBOLS - 1)].position.load(std::memory_order_relaxed);
+    }
+    int64_t openNotionalTicks(uint32_t symbol_id) const {
+        return symbols_[symbol_id & (SymbolTable::MAX_SYMBOLS - 1)].open_notional.load(std::memory_order_relaxed);
+    }
+    int64_t accountOpenNotionalTicks() const {
+        return account_open_notional_.load(std::memory_order_relaxed);
+    }
+
+private:
+    // One symbol's live risk state and limits, padded to two cache lines so
+    // hot counters and cold limits on neighbouring symbols never false-share.
+    struct alignas(128) SymbolSlot {
+        // Counters, maintained by the order flow.
+        std::atomic<int64_t> position{0};
+        std::atomic<int64_t> open_buy_qty{0};
+        std::atomic<int64_t> open_sell_qty{0};
+        std::atomic<int64_t> open_notional{0};
+        std::atomic<int64_t> rate_window_start_ns{0};
+        std::atomic<int32_t> rate_count{0};
+
+        // Limits, written by the control channel. Defaults are permissive so
+        // an unconfigured symbol trades; the config loader tightens them.
+        std::atomic<int32_t> max_order_size{INT32_MAX};
+        std::atomic<int64_t> max_position{UNLIMITED};
+        std::atomic<int64_t> max_open_notional{UNLIMITED};
+        std::atomic<int32_t> max_orders_per_sec{INT32_MAX};
+    };
+
+    // One-second tumbling window per symbol. The CAS on the window start
+    // means exactly one thread resets the count at a boundary; losing the
+    // race just counts the order against the fresh window.
+    static bool passRateLimit(SymbolSlot& slot) {
+        const int32_t max_rate = slot.max_orders_per_sec.load(std::memory_order_relaxed);
+        if (max_rate == INT32_MAX) {
+            return true;
+        }
+        const int64_t now_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+        int64_t window = slot.rate_window_start_ns.load(std::memory_order_relaxed);
+        if (now_ns - window >= 1000000000LL) {
+            if (slot.rate_window_start_ns.compare_exchange_strong(window, now_ns,
+                                                                  std::memory_order_relaxed)) {
+                slot.rate_count.store(0, std::memory_order_relaxed);
+            }
+        }
+        return slot.rate_count.fetch_add(1, std::memory_order_relaxed) < max_rate;
+    }
+
+    SymbolSlot symbols_[SymbolTable::MAX_SYMBOLS];
+    std::atomic<int64_t> account_open_notional_{0};
+    std::atomic<int64_t> account_max_open_notional_{UNLIMITED};
+};
+
+#endif  // RISK_ENGINE_HPP
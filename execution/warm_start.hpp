@@ -0,0 +1,240 @@
+#ifndef WARM_START_HPP
+#define WARM_START_HPP
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+// Warm-start snapshotting.
+//
+// A cold restart comes up blind: the order slabs are empty and every
+// strategy window needs its full lookback of ticks before it produces a
+// signal again — minutes at low-liquidity times. A warm start instead
+// restores from a snapshot file plus the binary order journal for the
+// delta, and is quoting again in well under a second.
+//
+// The snapshot format is a flat section file: a fixed header carrying the
+// snapshot timestamp, a table of (section id, offset, size) entries, then
+// raw section payloads. Sections hold trivially-copyable state only — order
+// slabs, generation arrays, strategy rolling windows — so writing is a
+// memcpy per section and restoring is an mmap plus memcpys back out; there
+// is no parsing and no per-record work on the restore path. Writers build
+// the image in memory and publish it with a write-to-temp-then-rename, so a
+// crash mid-snapshot leaves the previous snapshot intact.
+//
+// Consistency: the caller snapshots each component under that component's
+// own lock (OrderManager goes shard by shard). Events that land between the
+// snapshot timestamp and the crash are recovered by replaying the order
+// journal's records with ts_ns past the snapshot's — see
+// OrderManager::restoreSnapshot.
+
+constexpr uint32_t SNAPSHOT_MAGIC = 0x50414E53;  // "SNAP"
+constexpr uint32_t SNAPSHOT_VERSION = 1;
+constexpr uint32_t SNAPSHOT_MAX_SECTIONS = 128;
+
+struct SnapshotHeader {
+    uint32_t magic;
+    uint32_t version;
+    uint64_t snapshot_ts_ns;   // system_clock ns; journal delta starts here
+    uint32_t section_count;
+    uint32_t pad;
+};
+
+struct SnapshotSection {
+    uint32_t id;
+    uint32_t pad;
+    uint64_t offset;           // From file start
+    uint64_t size;
+};
+
+static_assert(std::is_trivially_copyable<SnapshotHeader>::value, "on-disk format");
+static_assert(std::is_trivially_copyable<SnapshotSection>::value, "on-disk format");
+
+// Accumulates sections in memory, publishes atomically on close().
+class SnapshotWriter {
+public:
+    explicit SnapshotWriter(const std::string& path) : path_(path) {
+        header_.magic = SNAPSHOT_MAGIC;
+        header_.version = SNAPSHOT_VERSION;
+        header_.snapshot_ts_ns = static_cast<uint64_t>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::system_clock::now().time_since_epoch()).count());
+        header_.section_count = 0;
+        header_.pad = 0;
+    }
+
+    // Raw section write; id must be unique within the snapshot.
+    bool writeSection(uint32_t id, const void* data, std::size_t size) {
+        if (sections_.size() >= SNAPSHOT_MAX_SECTIONS) {
+            return false;
+        }
+        SnapshotSection section{};
+        section.id = id;
+        section.size = size;
+        sections_.push_back(section);
+        const char* bytes = static_cast<const char*>(data);
+        payload_.insert(payload_.end(), bytes, bytes + size);
+        return true;
+    }
+
+    template <typename T>
+    bool writePod(uint32_t id, const T& value) {
+        static_assert(std::is_trivially_copyable<T>::value,
+                      "snapshot sections hold trivially-copyable state only");
+        return writeSection(id, &value, sizeof(T));
+    }
+
+    template <typename T>
+    bool writeArray(uint32_t id, const T* values, std::size_t count) {
+        static_assert(std::is_trivially_copyable<T>::value,
+                      "snapshot sections hold trivially-copyable state only");
+        return writeSection(id, values, count * sizeof(T));
+    }
+
+    // Lay the file out, write it to <path>.tmp and rename over the old
+    // snapshot — readers only ever see a complete image.
+    bool close() {
+        header_.section_count = static_cast<uint32_t>(sections_.size());
+        uint64_t offset = sizeof(SnapshotHeader) + sections_.size() * sizeof(SnapshotSection);
+        for (SnapshotSection& section : sections_) {
+            section.offset = offset;
+            offset += section.size;
+        }
+
+        const std::string tmp = path_ + ".tmp";
+        const int fd = ::open(tmp.c_str(), O_CREAT | O_TRUNC | O_WRONLY, 0644);
+        if (fd < 0) {
+            return false;
+        }
+        bool ok = writeAll(fd, &header_, sizeof(header_)) &&
+                  writeAll(fd, sections_.data(), sections_.size() * sizeof(SnapshotSection)) &&
+                  writeAll(fd, payload_.data(), payload_.size());
+        ok = (::fsync(fd) == 0) && ok;
+        ::close(fd);
+        if (!ok) {
+            ::unlink(tmp.c_str());
+            return false;
+        }
+        return ::rename(tmp.c_str(), path_.c_str()) == 0;
+    }
+
+    uint64_t snapshotTsNs() const { return header_.snapshot_ts_ns; }
+
+private:
+    static bool writeAll(int fd, const void* data, std::size_t size) {
+        const char* p = static_cast<const char*>(data);
+        while (size > 0) {
+            const ssize_t n = ::write(fd, p, size);
+            if (n <= 0) {
+                return false;
+            }
+            p += n;
+            size -= static_cast<std::size_t>(n);
+        }
+        return true;
+    }
+
+    std::string path_;
+    SnapshotHeader header_;
+    std::vector<SnapshotSection> sections_;
+    std::vector<char> payload_;
+};
+
+// Maps the snapshot read-only; section lookups return pointers into the
+// mapping, so a restore is memcpys straight out of the page cache.
+class SnapshotReader {
+public:
+    SnapshotReader() = default;
+
+    ~SnapshotReader() {
+        if (base_ != nullptr) {
+            ::munmap(base_, file_size_);
+        }
+    }
+
+    SnapshotReader(const SnapshotReader&) = delete;
+    SnapshotReader& operator=(const SnapshotReader&) = delete;
+
+    bool open(const std::string& path) {
+        const int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) {
+            return false;
+        }
+        struct stat st{};
+        if (::fstat(fd, &st) != 0 || static_cast<std::size_t>(st.st_size) < sizeof(SnapshotHeader)) {
+            ::close(fd);
+            return false;
+        }
+        file_size_ = static_cast<std::size_t>(st.st_size);
+        base_ = ::mmap(nullptr, file_size_, PROT_READ, MAP_PRIVATE, fd, 0);
+        ::close(fd);
+        if (base_ == MAP_FAILED) {
+            base_ = nullptr;
+            return false;
+        }
+        std::memcpy(&header_, base_, sizeof(header_));
+        if (header_.magic != SNAPSHOT_MAGIC || header_.version != SNAPSHOT_VERSION ||
+            header_.section_count > SNAPSHOT_MAX_SECTIONS) {
+            ::munmap(base_, file_size_);
+            base_ = nullptr;
+            return false;
+        }
+        return true;
+    }
+
+    uint64_t snapshotTsNs() const { return header_.snapshot_ts_ns; }
+
+    // Pointer and size of a section, or nullptr if absent.
+    const void* section(uint32_t id, std::size_t& size_out) const {
+        const SnapshotSection* table = reinterpret_cast<const SnapshotSection*>(
+            static_cast<const char*>(base_) + sizeof(SnapshotHeader));
+        for (uint32_t i = 0; i < header_.section_count; ++i) {
+            if (table[i].id == id && table[i].offset + table[i].size <= file_size_) {
+                size_out = table[i].size;
+                return static_cast<const char*>(base_) + table[i].offset;
+            }
+        }
+        size_out = 0;
+        return nullptr;
+    }
+
+    template <typename T>
+    bool readPod(uint32_t id, T& out) const {
+        static_assert(std::is_trivially_copyable<T>::value,
+                      "snapshot sections hold trivially-copyable state only");
+        std::size_t size = 0;
+        const void* data = section(id, size);
+        if (data == nullptr || size != sizeof(T)) {
+            return false;
+        }
+        std::memcpy(&out, data, sizeof(T));
+        return true;
+    }
+
+    template <typename T>
+    bool readArray(uint32_t id, T* out, std::size_t count) const {
+        static_assert(std::is_trivially_copyable<T>::value,
+                      "snapshot sections hold trivially-copyable state only");
+        std::size_t size = 0;
+        const void* data = section(id, size);
+        if (data == nullptr || size != count * sizeof(T)) {
+            return false;
+        }
+        std::memcpy(out, data, size);
+        return true;
+    }
+
+private:
+    void* base_ = nullptr;
+    std::size_t file_size_ = 0;
+    SnapshotHeader header_{};
+};
+
+#endif  // WARM_START_HPP
@@ -2,9 +2,14 @@
 #include <vector>
 #include <cmath>
 #include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstdlib>
 #include <random>
 #include <chrono>
 #include <string>
+#include <thread>
+#include <unordered_map>
 
 class MarketCondition {
 public:
@@ -16,104 +21,332 @@ public:
         : price_change_percentage(price_change), volatility(vol), liquidity(liq) {}
 };
 
-class Asset {
+// 64-byte aligned allocator so the SoA arrays start on cache-line (and SIMD
+// register) boundaries.
+template <typename T>
+struct AlignedAllocator {
+    using value_type = T;
+    AlignedAllocator() = default;
+    template <typename U>
+    AlignedAllocator(const AlignedAllocator<U>&) {}
+    T* allocate(std::size_t n) {
+        return static_cast<T*>(std::aligned_alloc(64, ((n * sizeof(T) + 63) / 64) * 64));
+    }
+    void deallocate(T* p, std::size_t) { std::free(p); }
+    template <typename U>
+    bool operator==(const AlignedAllocator<U>&) const { return true; }
+    template <typename U>
+    bool operator!=(const AlignedAllocator<U>&) const { return false; }
+};
+
+using AlignedDoubles = std::vector<double, AlignedAllocator<double>>;
+
+// Revaluation kernels shared by get_total_value() and the stress scenarios.
+// Pure strided math over contiguous aligned arrays — the compiler turns each
+// loop into packed fused multiply-adds, where the old vector<Asset> walk
+// dragged a std::string and 60+ bytes of object through the cache per asset
+// to do 16 bytes of work.
+
+// Sum of value[i] * position[i].
+inline double portfolio_exposure(const double* values, const double* positions, std::size_t n) {
+    double total = 0.0;
+    for (std::size_t i = 0; i < n; ++i) {
+        total += values[i] * positions[i];
+    }
+    return total;
+}
+
+// Sum of value[i] * (1 + shock[i] * liquidity_factor) * position[i].
+inline double portfolio_revalue(const double* values, const double* positions,
+                                const double* shocks, double liquidity_factor, std::size_t n) {
+    double total = 0.0;
+    for (std::size_t i = 0; i < n; ++i) {
+        total += values[i] * (1.0 + shocks[i] * liquidity_factor) * positions[i];
+    }
+    return total;
+}
+
+// Structure-of-arrays portfolio: initial values and position sizes in
+// contiguous aligned arrays the kernels stream over; asset names interned to
+// dense ids in a side table, looked up only for reporting.
+class PortfolioSoA {
 public:
-    std::string name;
-    double initial_value;
-    double position_size;
+    void add_asset(const std::string& name, double value, double position) {
+        auto it = ids_.find(name);
+        if (it != ids_.end()) {
+            initial_values_[it->second] = value;
+            position_sizes_[it->second] = position;
+            return;
+        }
+        ids_.emplace(name, static_cast<uint32_t>(names_.size()));
+        names_.push_back(name);
+        initial_values_.push_back(value);
+        position_sizes_.push_back(position);
+    }
 
-    Asset(std::string asset_name, double asset_value, double position)
-        : name(asset_name), initial_value(asset_value), position_size(position) {}
+    double get_total_value() const {
+        return portfolio_exposure(initial_values_.data(), position_sizes_.data(), size());
+    }
+
+    std::size_t size() const { return names_.size(); }
+    const double* initial_values() const { return initial_values_.data(); }
+    const double* position_sizes() const { return position_sizes_.data(); }
+    const std::string& name(std::size_t id) const { return names_[id]; }
+
+private:
+    AlignedDoubles initial_values_;
+    AlignedDoubles position_sizes_;
+    std::vector<std::string> names_;           // Reporting only — off the math path
+    std::unordered_map<std::string, uint32_t> ids_;
 };
 
-class Portfolio {
+// Counter-based RNG (Philox4x32-10). A draw is a pure function of
+// (key, counter), so every (scenario, path, asset) coordinate maps to its own
+// independent stream: no shared state to serialize threads the way rand()
+// did, no per-thread seeding ceremony, and results are bit-identical no
+// matter how the work is tiled across the pool.
+class PhiloxRng {
 public:
-    std::vector<Asset> assets;
+    PhiloxRng(uint64_t seed, uint64_t stream)
+        : key0_(static_cast<uint32_t>(seed)), key1_(static_cast<uint32_t>(seed >> 32)) {
+        counter_[2] = static_cast<uint32_t>(stream);
+        counter_[3] = static_cast<uint32_t>(stream >> 32);
+    }
 
-    void add_asset(const std::string& name, double value, double position) {
-        assets.emplace_back(name, value, position);
+    // Position the counter at a (path, asset-block) coordinate.
+    void seek(uint64_t position) {
+        counter_[0] = static_cast<uint32_t>(position);
+        counter_[1] = static_cast<uint32_t>(position >> 32);
+        have_spare_ = false;
     }
 
-    double get_total_value() const {
-        double total = 0.0;
-        for (const auto& asset : assets) {
-            total += asset.initial_value * asset.position_size;
+    // Standard normal via Box-Muller over two uniform draws.
+    double normal() {
+        if (have_spare_) {
+            have_spare_ = false;
+            return spare_;
+        }
+        uint32_t out[4];
+        block(out);
+        advance();
+        const double u1 = (out[0] + 1.0) * (1.0 / 4294967296.0);  // (0,1]
+        const double u2 = out[1] * (1.0 / 4294967296.0);          // [0,1)
+        const double r = std::sqrt(-2.0 * std::log(u1));
+        spare_ = r * std::sin(2.0 * M_PI * u2);
+        have_spare_ = true;
+        return r * std::cos(2.0 * M_PI * u2);
+    }
+
+private:
+    static constexpr uint32_t MULT_A = 0xD2511F53;
+    static constexpr uint32_t MULT_B = 0xCD9E8D57;
+    static constexpr uint32_t WEYL_A = 0x9E3779B9;
+    static constexpr uint32_t WEYL_B = 0xBB67AE85;
+
+    void block(uint32_t out[4]) const {
+        uint32_t c0 = counter_[0], c1 = counter_[1], c2 = counter_[2], c3 = counter_[3];
+        uint32_t k0 = key0_, k1 = key1_;
+        for (int round = 0; round < 10; ++round) {
+            const uint64_t p0 = static_cast<uint64_t>(MULT_A) * c0;
+            const uint64_t p1 = static_cast<uint64_t>(MULT_B) * c2;
+            const uint32_t hi0 = static_cast<uint32_t>(p0 >> 32), lo0 = static_cast<uint32_t>(p0);
+            const uint32_t hi1 = static_cast<uint32_t>(p1 >> 32), lo1 = static_cast<uint32_t>(p1);
+            c0 = hi1 ^ c1 ^ k0;
+            c1 = lo1;
+            c2 = hi0 ^ c3 ^ k1;
+            c3 = lo0;
+            k0 += WEYL_A;
+            k1 += WEYL_B;
         }
-        return total;
+        out[0] = c0; out[1] = c1; out[2] = c2; out[3] = c3;
     }
+
+    void advance() {
+        if (++counter_[0] == 0) {
+            ++counter_[1];
+        }
+    }
+
+    uint32_t counter_[4] = {0, 0, 0, 0};
+    uint32_t key0_;
+    uint32_t key1_;
+    double spare_ = 0.0;
+    bool have_spare_ = false;
+};
+
+// Per-scenario Monte Carlo distribution summary.
+struct ScenarioDistribution {
+    double mean_value = 0.0;
+    double var_95 = 0.0;   // Loss at the 95th percentile
+    double var_99 = 0.0;   // Loss at the 99th percentile
+    double es_95 = 0.0;    // Expected shortfall beyond VaR95
+    double es_99 = 0.0;    // Expected shortfall beyond VaR99
+    double worst_value = 0.0;
 };
 
 class StressTest {
 private:
-    Portfolio portfolio;
+    // Paths are simulated in tiles of PATH_TILE so a worker's working set
+    // (tile of path values plus one pass over the asset book) stays cache
+    // resident; workers pull tiles off a shared atomic index.
+    static constexpr int PATH_TILE = 256;
+
+    PortfolioSoA portfolio;
     std::vector<MarketCondition> scenarios;
+    std::vector<ScenarioDistribution> distributions;
     std::vector<double> portfolio_values;
     std::vector<double> drawdowns;
     std::vector<double> volatility_impacts;
+    int num_paths_ = 10000;
+    uint64_t seed_ = 0x5742E55;
 
-    double simulate_asset_value(const Asset& asset, double price_change_percentage, double volatility, double liquidity) {
-        // Model asset value with price change, volatility, and liquidity
-        double shock = price_change_percentage + volatility * (rand() % 100) / 100.0;
-        double liquidity_factor = 1.0 - std::min(std::max(0.0, liquidity), 1.0); // Liquidity: 0 (no liquidity) to 1 (full liquidity)
-        return asset.initial_value * (1 + shock * liquidity_factor) * asset.position_size;
-    }
-
-    double simulate_portfolio_value(double price_change_percentage, double volatility, double liquidity) {
-        // Simulate the value of the entire portfolio under stress
-        double portfolio_value = 0.0;
-        for (const auto& asset : portfolio.assets) {
-            portfolio_value += simulate_asset_value(asset, price_change_percentage, volatility, liquidity);
+    // One path's portfolio value under a scenario. The RNG is counter-based:
+    // seeking to (path * asset_count) gives the path its own stream slice,
+    // identical regardless of which thread runs it. Shocks are drawn into the
+    // caller's scratch array first, then the revaluation runs as one SIMD
+    // pass over the SoA arrays.
+    double simulate_path(const MarketCondition& scenario, PhiloxRng& rng, uint64_t path,
+                         AlignedDoubles& shocks) const {
+        const std::size_t n = portfolio.size();
+        rng.seek(path * static_cast<uint64_t>(n));
+        for (std::size_t i = 0; i < n; ++i) {
+            shocks[i] = scenario.price_change_percentage + scenario.volatility * rng.normal();
         }
-        return portfolio_value;
+        const double liquidity_factor = 1.0 - std::min(std::max(0.0, scenario.liquidity), 1.0);
+        return portfolio_revalue(portfolio.initial_values(), portfolio.position_sizes(),
+                                 shocks.data(), liquidity_factor, n);
     }
 
-    double calculate_drawdown(double initial_value, double new_value) {
+    double calculate_drawdown(double initial_value, double new_value) const {
         return (initial_value - new_value) / initial_value * 100;
     }
 
-    double calculate_volatility_impact(double volatility) {
+    double calculate_volatility_impact(double volatility) const {
         return volatility * 100; // Impact percentage of volatility
     }
 
+    // Reduce one scenario's sorted path values into its distribution.
+    ScenarioDistribution summarize(std::vector<double>& path_values, double initial_value) const {
+        std::sort(path_values.begin(), path_values.end());
+        const std::size_t n = path_values.size();
+        ScenarioDistribution dist;
+        double sum = 0.0;
+        for (double v : path_values) {
+            sum += v;
+        }
+        dist.mean_value = sum / n;
+        dist.worst_value = path_values.front();
+
+        const std::size_t idx95 = n - (n * 95) / 100;  // Left tail of the value distribution
+        const std::size_t idx99 = n - (n * 99) / 100;
+        dist.var_95 = initial_value - path_values[idx95];
+        dist.var_99 = initial_value - path_values[idx99];
+
+        double tail_sum = 0.0;
+        for (std::size_t i = 0; i <= idx95; ++i) {
+            tail_sum += path_values[i];
+        }
+        dist.es_95 = initial_value - tail_sum / (idx95 + 1);
+        tail_sum = 0.0;
+        for (std::size_t i = 0; i <= idx99; ++i) {
+            tail_sum += path_values[i];
+        }
+        dist.es_99 = initial_value - tail_sum / (idx99 + 1);
+        return dist;
+    }
+
 public:
-    StressTest(const Portfolio& port)
+    StressTest(const PortfolioSoA& port)
         : portfolio(port) {}
 
     void add_scenario(double price_change_percentage, double volatility, double liquidity) {
         scenarios.emplace_back(price_change_percentage, volatility, liquidity);
     }
 
-    void run_tests() {
+    void set_paths(int num_paths) {
+        num_paths_ = num_paths;
+    }
+
+    // Monte Carlo over every scenario: num_paths paths each, tiled across a
+    // worker pool. Workers write disjoint slices of the preallocated path
+    // arrays, so the parallel phase needs no locks; each (scenario, path)
+    // owns its own counter-based RNG stream, so the statistics are clean and
+    // the run is reproducible at any thread count.
+    void run_tests(unsigned num_threads = std::thread::hardware_concurrency()) {
+        distributions.assign(scenarios.size(), ScenarioDistribution{});
         portfolio_values.clear();
         drawdowns.clear();
         volatility_impacts.clear();
-        double initial_value = portfolio.get_total_value();
+        const double initial_value = portfolio.get_total_value();
+
+        std::vector<std::vector<double>> path_values(scenarios.size());
+        for (auto& values : path_values) {
+            values.resize(num_paths_);
+        }
+
+        const int tiles_per_scenario = (num_paths_ + PATH_TILE - 1) / PATH_TILE;
+        const int total_tiles = tiles_per_scenario * static_cast<int>(scenarios.size());
+        std::atomic<int> next_tile{0};
 
-        for (const auto& scenario : scenarios) {
-            double new_value = simulate_portfolio_value(scenario.price_change_percentage, scenario.volatility, scenario.liquidity);
-            portfolio_values.push_back(new_value);
+        auto worker = [&]() {
+            AlignedDoubles shocks(portfolio.size());  // Per-worker scratch
+            for (;;) {
+                const int tile = next_tile.fetch_add(1, std::memory_order_relaxed);
+                if (tile >= total_tiles) {
+                    return;
+                }
+                const int scenario_idx = tile / tiles_per_scenario;
+                const int first_path = (tile % tiles_per_scenario) * PATH_TILE;
+                const int last_path = std::min(first_path + PATH_TILE, num_paths_);
+                // Stream id = scenario index: paths seek within the stream.
+                PhiloxRng rng(seed_, static_cast<uint64_t>(scenario_idx));
+                const MarketCondition& scenario = scenarios[scenario_idx];
+                for (int path = first_path; path < last_path; ++path) {
+                    path_values[scenario_idx][path] =
+                        simulate_path(scenario, rng, static_cast<uint64_t>(path), shocks);
+                }
+            }
+        };
 
-            double drawdown = calculate_drawdown(initial_value, new_value);
-            drawdowns.push_back(drawdown);
+        std::vector<std::thread> pool;
+        if (num_threads == 0) {
+            num_threads = 1;
+        }
+        for (unsigned i = 1; i < num_threads; ++i) {
+            pool.emplace_back(worker);
+        }
+        worker();  // The calling thread works too
+        for (auto& t : pool) {
+            t.join();
+        }
 
-            double vol_impact = calculate_volatility_impact(scenario.volatility);
-            volatility_impacts.push_back(vol_impact);
+        for (std::size_t i = 0; i < scenarios.size(); ++i) {
+            distributions[i] = summarize(path_values[i], initial_value);
+            portfolio_values.push_back(distributions[i].mean_value);
+            drawdowns.push_back(calculate_drawdown(initial_value, distributions[i].mean_value));
+            volatility_impacts.push_back(calculate_volatility_impact(scenarios[i].volatility));
         }
     }
 
     void generate_report() const {
-        std::cout << "Stress Test Report\n";
+        std::cout << "Stress Test Report (" << num_paths_ << " Monte Carlo paths per scenario)\n";
         std::cout << "Initial Portfolio Value: " << portfolio.get_total_value() << "\n";
         std::cout << "-----------------------------------------\n";
 
         for (size_t i = 0; i < scenarios.size(); ++i) {
             const auto& scenario = scenarios[i];
+            const auto& dist = distributions[i];
             std::cout << "Scenario " << i + 1 << ":\n";
             std::cout << " - Price Change: " << scenario.price_change_percentage * 100 << "%\n";
             std::cout << " - Volatility: " << scenario.volatility * 100 << "%\n";
             std::cout << " - Liquidity: " << scenario.liquidity * 100 << "%\n";
-            std::cout << " - Portfolio Value: " << portfolio_values[i] << "\n";
-            std::cout << " - Drawdown: " << drawdowns[i] << "%\n";
+            std::cout << " - Mean Portfolio Value: " << dist.mean_value << "\n";
+            std::cout << " - Mean Drawdown: " << drawdowns[i] << "%\n";
+            std::cout << " - VaR 95%: " << dist.var_95 << "\n";
+            std::cout << " - VaR 99%: " << dist.var_99 << "\n";
+            std::cout << " - ES 95%: " << dist.es_95 << "\n";
+            std::cout << " - ES 99%: " << dist.es_99 << "\n";
+            std::cout << " - Worst Path Value: " << dist.worst_value << "\n";
             std::cout << " - Volatility Impact: " << volatility_impacts[i] << "%\n";
             std::cout << "-----------------------------------------\n";
         }
@@ -121,9 +354,7 @@ public:
 };
 
 int main() {
-    srand(static_cast<unsigned>(std::chrono::system_clock::now().time_since_epoch().count()));
-
-    Portfolio portfolio;
+    PortfolioSoA portfolio;
     portfolio.add_asset("Stock A", 500000, 1.0);  // Asset name, value, position size
     portfolio.add_asset("Bond B", 300000, 1.0);
     portfolio.add_asset("Commodity C", 200000, 1.0);
@@ -137,11 +368,12 @@ int main() {
     stress_test.add_scenario(0.3, 0.15, 0.7);    // 30% price increase, 15% volatility, 70% liquidity
     stress_test.add_scenario(-0.1, 0.08, 0.4);   // 10% drop in price, 8% volatility, 40% liquidity
 
-    // Run stress tests
+    // Run stress tests: 10k paths per scenario across the machine's cores
+    stress_test.set_paths(10000);
     stress_test.run_tests();
 
     // Generate report
     stress_test.generate_report();
 
     return 0;
-}
\ No newline at end of file
+}
@@ -0,0 +1,46 @@
+import struct
+import sys
+from datetime import datetime, timezone
+
+# Offline renderer for the binary order journal written by OrderJournal
+# (execution/order_journal.hpp). The trading process only ever writes fixed
+# 48-byte OrderEvent records; turning them into human-readable text is this
+# script's job, not the hot path's.
+
+# Must match the OrderEvent layout in execution/order_journal.hpp
+EVENT_STRUCT = struct.Struct("<Qdiii12sBBBB4x")  # 4x = trailing struct padding
+EVENT_SIZE = 48
+
+ACTIONS = {0: "CREATE", 1: "CANCEL", 2: "MODIFY", 3: "UPDATE"}
+STATUSES = {0: "PENDING", 1: "FILLED", 2: "CANCELED", 3: "REJECTED", 4: "PARTIALLY_FILLED"}
+
+assert EVENT_STRUCT.size == EVENT_SIZE, "OrderEvent layout mismatch"
+
+
+def render_event(record: bytes) -> str:
+    ts_ns, price, order_id, qty, filled, symbol, action, status, is_buy, _pad = \
+        EVENT_STRUCT.unpack(record)
+    ts = datetime.fromtimestamp(ts_ns / 1e9, tz=timezone.utc)
+    symbol_text = symbol.rstrip(b"\x00").decode("ascii", "replace")
+    return (f"[{ts.isoformat()}] Action: {ACTIONS.get(action, str(action))}, "
+            f"Order ID: {order_id}, "
+            f"Symbol: {symbol_text}, "
+            f"Side: {'BUY' if is_buy else 'SELL'}, "
+            f"Price: {price:.4f}, Quantity: {qty}, Filled: {filled}, "
+            f"Status: {STATUSES.get(status, str(status))}")
+
+
+def render_journal(path: str):
+    with open(path, "rb") as f:
+        while True:
+            record = f.read(EVENT_SIZE)
+            if len(record) < EVENT_SIZE:
+                # A short trailing record is a torn final write after a
+                # crash; everything before it is still valid.
+                break
+            print(render_event(record))
+
+
+if __name__ == "__main__":
+    journal_path = sys.argv[1] if len(sys.argv) > 1 else "order_journal.bin"
+    render_journal(journal_path)
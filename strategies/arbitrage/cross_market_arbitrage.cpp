@@ -3,9 +3,13 @@
 #include <cmath>
 #include <chrono>
 #include <thread>
-#include "exchange_connector.h" 
-#include "order_manager.h"      
-#include "log_utils.h"         
+#include "exchange_connector.h"
+#include "order_manager.h"
+#include "log_utils.h"
+#include "market_messages.hpp"
+#include "connector_pool.hpp"
+#include "order_book.hpp"
+#include "metrics_registry.hpp"
 
 // Constants
 const double PRICE_DIFF_THRESHOLD = 0.05;  
@@ -21,6 +25,13 @@ struct MarketData {
     MarketData(double p, double v) : price(p), volume(v) {
         timestamp = std::chrono::system_clock::now();
     }
+
+    // View over a binary MarketTick from the connector ring. No parsing and
+    // no allocation — the fixed-point price is widened once at the boundary.
+    explicit MarketData(const MarketTick& tick)
+        : price(from_price_ticks(tick.price)), volume(tick.size) {
+        timestamp = std::chrono::system_clock::now();
+    }
 };
 
 // Function to fetch market data from multiple exchanges
@@ -70,81 +81,140 @@ void updateOrderStatus(OrderManager& orderManager) {
     orderManager.updateOrderStatus();
 }
 
-// Main function to execute cross-market arbitrage strategy
-void crossMarketArbitrage(ExchangeConnector& exchange1, ExchangeConnector& exchange2, OrderManager& orderManager) {
-    while (true) {
-        // Fetch latest market data from both exchanges
-        log_info("Fetching market data from Exchange 1 and Exchange 2.");
-        MarketData marketData1 = getMarketData(exchange1);
-        MarketData marketData2 = getMarketData(exchange2);
-
-        // Log the market data for monitoring
-        logMarketData(marketData1, "Exchange 1");
-        logMarketData(marketData2, "Exchange 2");
+// Depth-aware arbitrage attempt: buy the ask ladder on one venue, sell the
+// bid ladder on the other. Size is the largest quantity for which every
+// matched share clears the threshold against the opposite inside — computed
+// from the flat books' depth, where the old logic could only do
+// min(volume1, volume2) off two last prints. Returns true if a trade fired.
+bool tryDepthArbitrage(const OrderBook& buyBook, const OrderBook& sellBook,
+                       ExchangeConnector& buyVenue, ExchangeConnector& sellVenue) {
+    const OrderBook::Level ask = buyBook.best_ask();
+    const OrderBook::Level bid = sellBook.best_bid();
+    if (!ask.valid || !bid.valid) {
+        return false;
+    }
+    const PriceTicks threshold = to_price_ticks(PRICE_DIFF_THRESHOLD);
+    if (bid.price - ask.price < threshold) {
+        return false;
+    }
 
-        // Check if an arbitrage opportunity exists between the two exchanges
-        if (checkArbitrageOpportunity(marketData1, marketData2)) {
-            // Calculate the amount to trade, based on available volumes and position limits
-            double arbitrageAmount = std::min(marketData1.volume, marketData2.volume);
-            arbitrageAmount = std::min(arbitrageAmount, static_cast<double>(MAX_POSITION_SIZE));
+    // Take asks only up to (best bid - threshold) and bids only down to
+    // (best ask + threshold), so depth beyond the profitable band never
+    // inflates the size.
+    uint32_t size = std::min(buyBook.available_within(Side::BUY, bid.price - threshold),
+                             sellBook.available_within(Side::SELL, ask.price + threshold));
+    size = std::min(size, static_cast<uint32_t>(MAX_POSITION_SIZE));
+    if (size == 0) {
+        return false;
+    }
 
-            log_info("Arbitrage Amount: " + std::to_string(arbitrageAmount));
+    const OrderBook::SweepResult cost = buyBook.sweep_cost(Side::BUY, size);
+    const OrderBook::SweepResult proceeds = sellBook.sweep_cost(Side::SELL, size);
+    log_info("Depth arbitrage: size " + std::to_string(size) +
+             ", buy avg " + std::to_string(cost.avg_price()) +
+             ", sell avg " + std::to_string(proceeds.avg_price()) +
+             ", expected edge " + std::to_string(proceeds.avg_price() - cost.avg_price()));
 
-            // Execute the arbitrage trade
-            executeArbitrageTrade(exchange1, exchange2, arbitrageAmount);
+    buyVenue.placeOrder(OrderType::BUY, size);
+    sellVenue.placeOrder(OrderType::SELL, size);
+    return true;
+}
 
-            // Update order status in the order manager
-            updateOrderStatus(orderManager);
+// Main function to execute cross-market arbitrage strategy.
+//
+// The pool runs every venue connection on its own pinned thread and merges
+// their ticks into one stream ordered by local receive timestamp, so venue 2
+// is never stale by one fetch of venue 1 the way the old sequential polling
+// made it — and adding venues 3..6 is an add_venue call, not a rewrite.
+void crossMarketArbitrage(ConnectorPool<ExchangeConnector>& pool,
+                          std::vector<ExchangeConnector*>& venues,
+                          OrderManager& orderManager) {
+    // One L2 book per venue, maintained from the merged incremental stream.
+    std::vector<OrderBook> books(venues.size());
+    std::vector<bool> seen(venues.size(), false);
+
+    MarketTick tick{};
+    while (true) {
+        if (!pool.poll_merged(tick)) {
+            continue;  // Merge rings empty; the venue threads are filling them
+        }
+        if (tick.venue_id >= books.size()) {
+            continue;
+        }
+        books[tick.venue_id].apply(tick);
+        seen[tick.venue_id] = true;
+
+        // Compare the updated venue against every other venue we have data
+        // for; only pairs involving the fresh tick can have changed.
+        for (std::size_t other = 0; other < books.size(); ++other) {
+            if (other == tick.venue_id || !seen[other]) {
+                continue;
+            }
+            const std::size_t fresh = tick.venue_id;
+            // Both directions: the fresh tick may have created an edge as
+            // either the cheap ask ladder or the rich bid ladder.
+            bool traded = tryDepthArbitrage(books[fresh], books[other], *venues[fresh], *venues[other]);
+            traded |= tryDepthArbitrage(books[other], books[fresh], *venues[other], *venues[fresh]);
+            if (traded) {
+                updateOrderStatus(orderManager);
+            }
         }
-
-        // Sleep to avoid excessive API requests to the exchanges
-        log_info("Sleeping for " + std::to_string(SLEEP_DURATION_MS) + " milliseconds.");
-        std::this_thread::sleep_for(std::chrono::milliseconds(SLEEP_DURATION_MS));
     }
 }
 
 // Main entry point of the program
 int main() {
-    // Initialize exchange connectors for two different markets
-    log_info("Initializing exchange connectors for Exchange 1 and Exchange 2.");
-    ExchangeConnector exchange1("https://exchange1.com");
-    ExchangeConnector exchange2("https://exchange2.com");
+    // Initialize exchange connectors — one per venue we trade. The pool owns
+    // a pinned thread per venue and fans ticks out by symbol id.
+    log_info("Initializing connector pool.");
+    auto exchange1 = std::make_shared<ExchangeConnector>("https://exchange1.com");
+    auto exchange2 = std::make_shared<ExchangeConnector>("https://exchange2.com");
+
+    ConnectorPool<ExchangeConnector> pool;
+    pool.add_venue(exchange1, /*venue_id=*/0, /*core_id=*/2);
+    pool.add_venue(exchange2, /*venue_id=*/1, /*core_id=*/3);
 
     // Initialize the order manager
     log_info("Initializing order manager.");
     OrderManager orderManager;
 
-    // Start the cross-market arbitrage strategy
+    // Start the pool threads, then consume the merged stream.
     log_info("Starting cross-market arbitrage strategy.");
-    crossMarketArbitrage(exchange1, exchange2, orderManager);
+    pool.start();
+    std::vector<ExchangeConnector*> venues = {exchange1.get(), exchange2.get()};
+    crossMarketArbitrage(pool, venues, orderManager);
 
     return 0;
 }
 
-// Additional functionality to monitor performance and metrics
+// Additional functionality to monitor performance and metrics.
+//
+// Counters live in the metrics registry (metrics_registry.hpp): the trading
+// loop's updateMetrics is wait-free increments on this thread's own slab,
+// and the display thread reads aggregated sums — the old plain-struct
+// version was a data race between the two. Profit is accumulated in price
+// ticks so the counter stays integral.
 struct PerformanceMetrics {
-    double totalProfit;
-    int totalTrades;
-    int successfulArbitrages;
-    int failedArbitrages;
-
-    PerformanceMetrics() : totalProfit(0), totalTrades(0), successfulArbitrages(0), failedArbitrages(0) {}
+    Counter totalProfitTicks{"arb.profit_ticks"};
+    Counter totalTrades{"arb.trades"};
+    Counter successfulArbitrages{"arb.success"};
+    Counter failedArbitrages{"arb.failed"};
 
     void logMetrics() const {
         log_info("Performance Metrics:");
-        log_info("Total Profit: " + std::to_string(totalProfit));
-        log_info("Total Trades: " + std::to_string(totalTrades));
-        log_info("Successful Arbitrages: " + std::to_string(successfulArbitrages));
-        log_info("Failed Arbitrages: " + std::to_string(failedArbitrages));
+        log_info("Total Profit: " + std::to_string(from_price_ticks(totalProfitTicks.sum())));
+        log_info("Total Trades: " + std::to_string(totalTrades.sum()));
+        log_info("Successful Arbitrages: " + std::to_string(successfulArbitrages.sum()));
+        log_info("Failed Arbitrages: " + std::to_string(failedArbitrages.sum()));
     }
 
     void updateMetrics(double profit, bool success) {
-        totalProfit += profit;
-        totalTrades++;
+        totalProfitTicks.add(to_price_ticks(profit));
+        totalTrades.inc();
         if (success) {
-            successfulArbitrages++;
+            successfulArbitrages.inc();
         } else {
-            failedArbitrages++;
+            failedArbitrages.inc();
         }
     }
 };
@@ -190,7 +260,9 @@ void executeArbitrageTradeWithMetrics(ExchangeConnector& exchange1, ExchangeConn
     }
 }
 
-// Function to display detailed performance statistics periodically
+// Function to display detailed performance statistics periodically. Reads
+// go through the registry's per-thread slab sums, so this no longer races
+// the trading loop's increments.
 void displayPerformanceStatistics(PerformanceMetrics& metrics) {
     while (true) {
         // Log and display metrics every minute
@@ -200,8 +272,16 @@ void displayPerformanceStatistics(PerformanceMetrics& metrics) {
 }
 
 // Main function to execute cross-market arbitrage with performance tracking
-void crossMarketArbitrageWithMetrics(ExchangeConnector& exchange1, ExchangeConnector& exchange2, 
+void crossMarketArbitrageWithMetrics(ExchangeConnector& exchange1, ExchangeConnector& exchange2,
                                      OrderManager& orderManager, PerformanceMetrics& metrics) {
+    // Publish aggregated counters into the dashboard's shared-memory
+    // snapshot every second; the live dashboard picks them up from the
+    // performance_metrics block.
+    static DashboardPublisher dashboard;
+    if (dashboard.create()) {
+        MetricsRegistry::instance().startAggregator(&dashboard);
+    }
+
     // Launch a separate thread to display performance statistics periodically
     std::thread performanceThread(displayPerformanceStatistics, std::ref(metrics));
     performanceThread.detach();
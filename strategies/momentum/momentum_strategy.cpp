@@ -6,34 +6,41 @@
 #include <ctime>   
 #include <iomanip>  
 #include <fstream> 
+#include "rolling_window.hpp"
+#include "strategy_list.hpp"
+#include "warm_start.hpp"
+
+// Compile-time capacity bounds for the rolling kernels. Periods stay runtime
+// parameters; these only cap how large they may be configured.
+constexpr std::size_t MAX_MA_PERIOD = 256;
+constexpr std::size_t MAX_LOOKBACK = 256;
 
 // Utility function to print a line separator for better output readability
 void printSeparator() {
     std::cout << "------------------------------------" << std::endl;
 }
 
-// Class to manage the moving average calculations for momentum
+// Class to manage the moving average calculations for momentum.
+// Backed by a RollingWindow so adding a value is O(1) (the old vector
+// erase(begin()) was an O(n) memmove per tick) and the average reads a
+// running sum instead of re-accumulating the whole window per call.
 class MovingAverage {
 private:
     int period;
-    std::vector<double> values;
+    RollingWindow<double, MAX_MA_PERIOD> values;
 
 public:
-    MovingAverage(int p) : period(p) {}
+    MovingAverage(int p) : period(p), values(static_cast<std::size_t>(p)) {}
 
     void addValue(double value) {
-        values.push_back(value);
-        if (values.size() > period) {
-            values.erase(values.begin());
-        }
+        values.push(value);
     }
 
     double getAverage() const {
-        if (values.size() < period) {
+        if (!values.full()) {
             return 0.0; // Not enough data to compute average
         }
-        double sum = std::accumulate(values.begin(), values.end(), 0.0);
-        return sum / values.size();
+        return values.average();
     }
 
     int getPeriod() const {
@@ -41,14 +48,18 @@ public:
     }
 
     bool isReady() const {
-        return values.size() >= period;
+        return values.full();
     }
 };
 
-// Main Momentum Strategy Class
-class MomentumStrategy {
+// Main Momentum Strategy Class. Derives from the CRTP StrategyBase so it
+// composes into a StrategyList: ticks arrive through the statically-bound
+// onTick adapter (which forwards to onNewPrice) with no virtual dispatch.
+class MomentumStrategy : public StrategyBase<MomentumStrategy> {
 private:
-    std::vector<double> prices;
+    // Bounded price history: the momentum computation only ever reaches back
+    // lookback_period ticks, so that is all we keep.
+    RollingWindow<double, MAX_LOOKBACK + 1> prices;
     int lookback_period;
     double momentum_threshold;
     double position_size;
@@ -59,16 +70,21 @@ private:
 public:
     // Constructor to initialize the strategy parameters
     MomentumStrategy(int short_ma_period, int long_ma_period, double threshold, double size)
-        : lookback_period(short_ma_period), momentum_threshold(threshold), position_size(size),
+        : prices(static_cast<std::size_t>(short_ma_period) + 1), lookback_period(short_ma_period),
+          momentum_threshold(threshold), position_size(size),
           position_open(false), short_term_ma(short_ma_period), long_term_ma(long_ma_period) {}
 
-    // Function to calculate the momentum
+    // Function to calculate the momentum. O(1): the window keeps exactly
+    // lookback_period + 1 prices, so the reference is a fixed offset from the
+    // oldest entry instead of an index into an ever-growing vector.
     double calculateMomentum() {
-        if (prices.size() < lookback_period) {
+        if (!prices.full()) {
             return 0.0; // Not enough data
         }
-        double momentum = (prices.back() - prices[prices.size() - lookback_period]) / prices[prices.size() - lookback_period];
-        return momentum;
+        // at(1) is prices[size - lookback] in the old unbounded-vector
+        // indexing: lookback-1 intervals behind the newest price.
+        double reference = prices.at(1);
+        return (prices.back() - reference) / reference;
     }
 
     // Function to calculate the short-term and long-term moving averages
@@ -79,10 +95,10 @@ public:
 
     // Function to process new price data and check for trading signals
     void onNewPrice(double price) {
-        prices.push_back(price);
+        prices.push(price);
         calculateMovingAverages(price);
 
-        if (prices.size() > lookback_period) {
+        if (prices.full()) {
             double momentum = calculateMomentum();
             if (momentum > momentum_threshold && !position_open && short_term_ma.isReady() && long_term_ma.isReady()) {
                 if (short_term_ma.getAverage() > long_term_ma.getAverage()) {
@@ -117,8 +133,8 @@ public:
     // Print the price history (for monitoring purposes)
     void printPrices() const {
         std::cout << "Price history: ";
-        for (const auto& p : prices) {
-            std::cout << p << " ";
+        for (std::size_t i = 0; i < prices.size(); ++i) {
+            std::cout << prices.at(i) << " ";
         }
         std::cout << std::endl;
         printSeparator();
@@ -148,18 +164,160 @@ public:
         variance /= prices.size();
         return std::sqrt(variance);
     }
+
+    // Incremental variant: reads the window's maintained accumulators, so a
+    // live strategy gets per-tick volatility at O(1) instead of re-scanning.
+    template <std::size_t N>
+    static double calculateVolatility(const RollingWindow<double, N>& window) {
+        return window.stddev();
+    }
+};
+
+// One price update for one tracked symbol, for block evaluation.
+struct PriceTick {
+    uint32_t symbol_id;
+    double price;
+};
+
+// Vectorized multi-symbol momentum evaluation.
+//
+// One MomentumStrategy instance per symbol means ~800 scalar objects and a
+// virtual-ish dispatch per tick. This evaluator instead keeps all per-symbol
+// state as structure-of-arrays — running MA sums, last/reference prices, and
+// warm-up flags in contiguous arrays indexed by symbol id — so a whole block
+// of ticks is absorbed with cheap scatters and the signal conditions for
+// every tracked symbol are then evaluated in one branch-light loop the
+// compiler can vectorize. Results come back as buy/sell bitmasks (one bit
+// per symbol id) that the order path scans with countr_zero-style iteration.
+class MomentumBatchEvaluator {
+public:
+    MomentumBatchEvaluator(std::size_t num_symbols, int short_period, int long_period, double threshold)
+        : num_symbols_(num_symbols), short_period_(short_period), long_period_(long_period),
+          momentum_threshold_(threshold),
+          short_hist_(num_symbols * short_period, 0.0),
+          long_hist_(num_symbols * long_period, 0.0),
+          short_pos_(num_symbols, 0), long_pos_(num_symbols, 0),
+          short_sum_(num_symbols, 0.0), long_sum_(num_symbols, 0.0),
+          last_price_(num_symbols, 0.0), ref_price_(num_symbols, 0.0),
+          fill_count_(num_symbols, 0),
+          position_open_(num_symbols, 0),
+          buy_mask_((num_symbols + 63) / 64, 0),
+          sell_mask_((num_symbols + 63) / 64, 0) {}
+
+    // Absorb a block of ticks, then evaluate every symbol's signal once.
+    // Ticks for the same symbol within a block apply in order; only the
+    // post-block state is signalled on, which is the point of batching.
+    void onNewPriceBatch(const PriceTick* ticks, std::size_t count) {
+        for (std::size_t i = 0; i < count; ++i) {
+            applyTick(ticks[i]);
+        }
+        evaluateSignals();
+    }
+
+    // Signal bitmasks from the last batch: bit s set = signal for symbol s.
+    const std::vector<uint64_t>& buySignals() const { return buy_mask_; }
+    const std::vector<uint64_t>& sellSignals() const { return sell_mask_; }
+
+    bool positionOpen(uint32_t symbol_id) const { return position_open_[symbol_id] != 0; }
+    double lastPrice(uint32_t symbol_id) const { return last_price_[symbol_id]; }
+
+private:
+    // Scatter one tick into the SoA state: O(1) ring updates of both MA
+    // windows plus the momentum reference. No signal logic here.
+    void applyTick(const PriceTick& tick) {
+        const uint32_t s = tick.symbol_id;
+        if (s >= num_symbols_) {
+            return;
+        }
+        const double price = tick.price;
+
+        double* srow = &short_hist_[static_cast<std::size_t>(s) * short_period_];
+        int spos = short_pos_[s];
+        short_sum_[s] += price - srow[spos];
+        srow[spos] = price;
+        spos = (spos + 1 == short_period_) ? 0 : spos + 1;
+        short_pos_[s] = spos;
+        // After the write, srow[spos] is the oldest short-window price —
+        // exactly prices[size - lookback] in the scalar strategy's indexing.
+        ref_price_[s] = srow[spos];
+
+        double* lrow = &long_hist_[static_cast<std::size_t>(s) * long_period_];
+        int lpos = long_pos_[s];
+        long_sum_[s] += price - lrow[lpos];
+        lrow[lpos] = price;
+        long_pos_[s] = (lpos + 1 == long_period_) ? 0 : lpos + 1;
+
+        last_price_[s] = price;
+        if (fill_count_[s] < long_period_) {
+            ++fill_count_[s];
+        }
+    }
+
+    // One pass over all symbols. Pure arithmetic and comparisons on
+    // contiguous arrays — no calls, no pointer chasing — so the compiler's
+    // vectorizer gets a clean run at it.
+    void evaluateSignals() {
+        const double inv_short = 1.0 / short_period_;
+        const double inv_long = 1.0 / long_period_;
+        for (std::size_t w = 0; w < buy_mask_.size(); ++w) {
+            uint64_t buy_bits = 0;
+            uint64_t sell_bits = 0;
+            const std::size_t base = w * 64;
+            const std::size_t end = std::min(base + 64, num_symbols_);
+            for (std::size_t s = base; s < end; ++s) {
+                const bool warm = fill_count_[s] >= long_period_;
+                const double momentum = (last_price_[s] - ref_price_[s]) /
+                                        (ref_price_[s] != 0.0 ? ref_price_[s] : 1.0);
+                const bool crossover = short_sum_[s] * inv_short > long_sum_[s] * inv_long;
+                const bool open = position_open_[s] != 0;
+                const bool buy = warm && !open && momentum > momentum_threshold_ && crossover;
+                const bool sell = warm && open && momentum < -momentum_threshold_;
+                const uint64_t bit = uint64_t{1} << (s - base);
+                buy_bits |= buy ? bit : 0;
+                sell_bits |= sell ? bit : 0;
+                position_open_[s] = static_cast<uint8_t>((open && !sell) || buy);
+            }
+            buy_mask_[w] = buy_bits;
+            sell_mask_[w] = sell_bits;
+        }
+    }
+
+    std::size_t num_symbols_;
+    int short_period_;
+    int long_period_;
+    double momentum_threshold_;
+
+    // Per-symbol ring storage, one contiguous row per symbol.
+    std::vector<double> short_hist_;
+    std::vector<double> long_hist_;
+    std::vector<int> short_pos_;
+    std::vector<int> long_pos_;
+
+    // SoA signal-pass state: indexed by symbol id, read linearly.
+    std::vector<double> short_sum_;
+    std::vector<double> long_sum_;
+    std::vector<double> last_price_;
+    std::vector<double> ref_price_;
+    std::vector<int> fill_count_;
+    std::vector<uint8_t> position_open_;
+
+    std::vector<uint64_t> buy_mask_;
+    std::vector<uint64_t> sell_mask_;
 };
 
 int main() {
-    // Initialize the strategy with a short-term MA of 5, long-term MA of 10, and a momentum threshold of 0.02
-    MomentumStrategy strategy(5, 10, 0.02, 1000);
+    // Compose the pipeline at compile time: a short-term MA of 5, long-term
+    // MA of 10, and a momentum threshold of 0.02. Adding a second strategy
+    // type here fans every tick out to it with zero dispatch overhead.
+    StrategyList<MomentumStrategy> pipeline(MomentumStrategy(5, 10, 0.02, 1000));
+    auto& strategy = pipeline.get<0>();
 
     // Price data feed
     std::vector<double> price_feed = {100.5, 101.0, 101.8, 102.5, 103.0, 104.0, 105.2, 106.0, 107.5, 108.2, 109.0};
 
-    // Feed prices into the strategy
+    // Feed prices into the pipeline
     for (double price : price_feed) {
-        strategy.onNewPrice(price);
+        pipeline.onTick(price);
         strategy.printPrices(); // Print price history after every new price
         strategy.displayMovingAverages(); // Display moving averages for monitoring
     }
@@ -169,50 +327,36 @@ int main() {
     std::cout << "Calculated volatility: " << volatility << std::endl;
     printSeparator();
 
-    return 0;
-}
-
-// Class to handle risk management
-class RiskManager {
-private:
-    double max_position_size;
-    double max_drawdown;
-    double current_position_size;
-    double peak_equity;
-    double current_equity;
-
-public:
-    RiskManager(double max_pos_size, double max_dd) 
-        : max_position_size(max_pos_size), max_drawdown(max_dd), current_position_size(0.0), peak_equity(0.0), current_equity(0.0) {}
-
-    // Update the current equity and adjust peak equity
-    void updateEquity(double new_equity) {
-        current_equity = new_equity;
-        if (current_equity > peak_equity) {
-            peak_equity = current_equity;
-        }
-    }
-
-    // Check if current position size exceeds risk limits
-    bool checkPositionSize(double size) {
-        current_position_size = size;
-        return current_position_size <= max_position_size;
+    // Batch mode: the same feed applied to two symbols at once, with signals
+    // read back as bitmasks instead of per-instance callbacks.
+    MomentumBatchEvaluator batch(2, 5, 10, 0.02);
+    std::vector<PriceTick> block;
+    for (double price : price_feed) {
+        block.push_back({0, price});
+        block.push_back({1, price * 1.01});
     }
+    batch.onNewPriceBatch(block.data(), block.size());
+    std::cout << "Batch buy mask: " << std::hex << batch.buySignals()[0]
+              << std::dec << std::endl;
+    printSeparator();
 
-    // Check if drawdown exceeds the allowed maximum
-    bool checkDrawdown() {
-        double drawdown = (peak_equity - current_equity) / peak_equity;
-        return drawdown <= max_drawdown;
+    // Warm start: the strategy is trivially copyable (rolling windows and
+    // scalars only), so its whole state snapshots as one POD section and a
+    // restart resumes mid-window instead of waiting out the lookback.
+    static_assert(std::is_trivially_copyable<MomentumStrategy>::value,
+                  "MomentumStrategy must stay memcpy-able for warm starts");
+    SnapshotWriter writer("strategy_state.snap");
+    writer.writePod(1, strategy);
+    writer.close();
+    MomentumStrategy restored(5, 10, 0.02, 1000);
+    SnapshotReader reader;
+    if (reader.open("strategy_state.snap") && reader.readPod(1, restored)) {
+        std::cout << "Warm-started strategy state:" << std::endl;
+        restored.printPrices();
     }
 
-    // Print current risk stats
-    void printRiskStatus() const {
-        std::cout << "Current Equity: " << current_equity << ", Peak Equity: " << peak_equity << std::endl;
-        std::cout << "Max Drawdown Allowed: " << max_drawdown * 100 << "%, Current Drawdown: " 
-                  << ((peak_equity - current_equity) / peak_equity) * 100 << "%" << std::endl;
-        printSeparator();
-    }
-};
+    return 0;
+}
 
 // Class to log strategy performance
 class Logger {
@@ -233,6 +377,11 @@ public:
         }
     }
 
+    // Movable (the stream moves with it) so a strategy owning a Logger can
+    // be placed into a StrategyList by value; still non-copyable.
+    Logger(Logger&&) = default;
+    Logger& operator=(Logger&&) = default;
+
     // Log strategy actions with timestamps
     void logAction(const std::string& action, double price) {
         if (log_file.is_open()) {
@@ -249,34 +398,40 @@ public:
     }
 };
 
-// Enhanced Momentum Strategy with Risk and Logging
-class EnhancedMomentumStrategy {
+// Enhanced Momentum Strategy with Risk and Logging. The risk/equity
+// plumbing that used to live in a hand-wired RiskManager member now comes
+// from the RiskManagedStrategy CRTP mixin, so the risk gate, mark-to-market
+// and the signal logic all inline into one statically-dispatched tick path.
+class EnhancedMomentumStrategy : public RiskManagedStrategy<EnhancedMomentumStrategy> {
 private:
-    std::vector<double> prices;
+    RollingWindow<double, MAX_LOOKBACK + 1> prices;
     int lookback_period;
     double momentum_threshold;
     double position_size;
     bool position_open;
     MovingAverage short_term_ma;
     MovingAverage long_term_ma;
-    RiskManager risk_manager;
     Logger logger;
-    double equity;
 
 public:
-    // Constructor initializing all parameters, risk manager, and logger
+    // Constructor initializing all parameters, risk limits, and logger
     EnhancedMomentumStrategy(int short_ma_period, int long_ma_period, double threshold, double size, double max_pos, double max_dd, const std::string& log_filename)
-        : lookback_period(short_ma_period), momentum_threshold(threshold), position_size(size), position_open(false),
+        : RiskManagedStrategy(max_pos, max_dd, 100000), // Start with an initial equity of 100k
+          prices(static_cast<std::size_t>(short_ma_period) + 1), lookback_period(short_ma_period),
+          momentum_threshold(threshold), position_size(size), position_open(false),
           short_term_ma(short_ma_period), long_term_ma(long_ma_period),
-          risk_manager(max_pos, max_dd), logger(log_filename), equity(100000) // Start with an initial equity of 100k
+          logger(log_filename)
     {}
 
-    // Calculate momentum
+    // Calculate momentum from the bounded window (O(1), see MomentumStrategy)
     double calculateMomentum() {
-        if (prices.size() < lookback_period) {
+        if (!prices.full()) {
             return 0.0; // Not enough data
         }
-        return (prices.back() - prices[prices.size() - lookback_period]) / prices[prices.size() - lookback_period];
+        // at(1) is prices[size - lookback] in the old unbounded-vector
+        // indexing: lookback-1 intervals behind the newest price.
+        double reference = prices.at(1);
+        return (prices.back() - reference) / reference;
     }
 
     // Calculate moving averages
@@ -287,23 +442,23 @@ public:
 
     // Process new price data and check for trading signals
     void onNewPrice(double price) {
-        prices.push_back(price);
+        prices.push(price);
         calculateMovingAverages(price);
 
         // Update equity after each price, consider it simple mark-to-market for the sake of logging and risk management
-        updateEquity(price);
+        markToMarket(position_open ? position_size * price : 0.0);
 
-        if (prices.size() > lookback_period) {
+        if (prices.full()) {
             double momentum = calculateMomentum();
             if (momentum > momentum_threshold && !position_open && short_term_ma.isReady() && long_term_ma.isReady()) {
-                if (short_term_ma.getAverage() > long_term_ma.getAverage() && risk_manager.checkPositionSize(position_size)) {
+                if (short_term_ma.getAverage() > long_term_ma.getAverage() && riskAllowsEntry(position_size)) {
                     buy(price);
                 }
             } else if (momentum < -momentum_threshold && position_open) {
                 sell(price);
             }
         }
-        risk_manager.printRiskStatus();
+        printRiskStatus();
     }
 
     // Execute buy order
@@ -312,7 +467,7 @@ public:
         printSeparator();
         position_open = true;
         logger.logAction("BUY", price);
-        equity -= position_size * price; // Update equity to account for the position
+        bookEntry(price, position_size); // Update equity to account for the position
     }
 
     // Execute sell order
@@ -321,31 +476,29 @@ public:
         printSeparator();
         position_open = false;
         logger.logAction("SELL", price);
-        equity += position_size * price; // Update equity to account for closing position
+        bookExit(price, position_size); // Update equity to account for closing position
     }
 
-    // Update equity
-    void updateEquity(double price) {
-        if (position_open) {
-            double current_value = position_size * price;
-            risk_manager.updateEquity(equity + current_value); // Mark-to-market equity update
-        } else {
-            risk_manager.updateEquity(equity); // Flat position, no change in equity
-        }
+    // Print current risk stats from the mixin's accounting
+    void printRiskStatus() const {
+        std::cout << "Current Equity: " << markedEquity() << ", Peak Equity: " << peakEquity() << std::endl;
+        std::cout << "Max Drawdown Allowed: " << maxDrawdown() * 100 << "%, Current Drawdown: "
+                  << ((peakEquity() - markedEquity()) / peakEquity()) * 100 << "%" << std::endl;
+        printSeparator();
     }
 
     // Reset the strategy for a new session
     void reset() {
         prices.clear();
         position_open = false;
-        equity = 100000; // Reset equity to initial value
+        resetEquity(100000); // Reset equity to initial value
     }
 
     // Display prices and moving averages (for monitoring)
     void printPrices() const {
         std::cout << "Price history: ";
-        for (const auto& p : prices) {
-            std::cout << p << " ";
+        for (std::size_t i = 0; i < prices.size(); ++i) {
+            std::cout << prices.at(i) << " ";
         }
         std::cout << std::endl;
         printSeparator();
@@ -360,15 +513,18 @@ public:
 };
 
 int main() {
-    // Initialize the enhanced strategy with logging and risk management
-    EnhancedMomentumStrategy strategy(5, 10, 0.02, 1000, 5000, 0.2, "strategy_log.txt");
+    // Compose the enhanced strategy into a compile-time pipeline; the whole
+    // tick path — risk mixin included — resolves to direct calls.
+    StrategyList<EnhancedMomentumStrategy> pipeline(
+        EnhancedMomentumStrategy(5, 10, 0.02, 1000, 5000, 0.2, "strategy_log.txt"));
+    auto& strategy = pipeline.get<0>();
 
     // Simulated price data feed
     std::vector<double> price_feed = {100.5, 101.0, 101.8, 102.5, 103.0, 104.0, 105.2, 106.0, 107.5, 108.2, 109.0};
 
-    // Feed prices into the strategy
+    // Feed prices into the pipeline
     for (double price : price_feed) {
-        strategy.onNewPrice(price);
+        pipeline.onTick(price);
         strategy.printPrices(); // Print price history after every new price
         strategy.displayMovingAverages(); // Display moving averages for monitoring
     }
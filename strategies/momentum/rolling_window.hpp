@@ -0,0 +1,98 @@
+#ifndef ROLLING_WINDOW_HPP
+#define ROLLING_WINDOW_HPP
+
+#include <array>
+#include <cmath>
+#include <cstddef>
+
+// Fixed-capacity rolling window with incremental statistics.
+//
+// Replaces the grow-forever vectors and per-call std::accumulate scans in the
+// momentum kernels: push() is O(1) (one slot overwrite plus running-sum
+// updates, no memmove), and average/variance read off maintained accumulators
+// instead of re-walking the window. Capacity N is a compile-time bound; the
+// effective window length is set at construction so strategies keep their
+// runtime-configurable periods.
+//
+// The running sum and sum-of-squares accumulate (value - offset) where offset
+// is the first value seen, which keeps the float cancellation error harmless
+// for price series that hover far from zero.
+template <typename T, std::size_t N>
+class RollingWindow {
+public:
+    explicit RollingWindow(std::size_t window_length = N)
+        : window_length_(window_length <= N ? window_length : N) {}
+
+    // Add a value; evicts the oldest once the window is full. O(1).
+    void push(T value) {
+        if (count_ == 0) {
+            offset_ = value;
+        }
+        const double centered = static_cast<double>(value) - offset_;
+        if (count_ == window_length_) {
+            // The element falling out of the window sits count_ slots behind
+            // the write position (capacity N may exceed the window length).
+            const std::size_t oldest_idx = (head_ + N - count_) % N;
+            const double oldest = static_cast<double>(values_[oldest_idx]) - offset_;
+            sum_ -= oldest;
+            sum_sq_ -= oldest * oldest;
+        } else {
+            ++count_;
+        }
+        values_[head_] = value;
+        head_ = (head_ + 1) % N;
+        sum_ += centered;
+        sum_sq_ += centered * centered;
+    }
+
+    std::size_t size() const { return count_; }
+    std::size_t window_length() const { return window_length_; }
+    bool full() const { return count_ == window_length_; }
+
+    // Mean of the values currently in the window. O(1).
+    double average() const {
+        return count_ == 0 ? 0.0 : offset_ + sum_ / static_cast<double>(count_);
+    }
+
+    // Population variance / standard deviation of the window. O(1).
+    double variance() const {
+        if (count_ < 2) {
+            return 0.0;
+        }
+        const double mean = sum_ / static_cast<double>(count_);
+        return sum_sq_ / static_cast<double>(count_) - mean * mean;
+    }
+
+    double stddev() const {
+        const double var = variance();
+        return var > 0.0 ? std::sqrt(var) : 0.0;
+    }
+
+    // Newest value in the window.
+    T back() const { return values_[(head_ + N - 1) % N]; }
+
+    // Oldest value in the window.
+    T front() const { return values_[(head_ + N - count_) % N]; }
+
+    // i-th value counted from the oldest (0 = front, size()-1 = back).
+    T at(std::size_t i) const { return values_[(head_ + N - count_ + i) % N]; }
+
+    void clear() {
+        head_ = 0;
+        count_ = 0;
+        sum_ = 0.0;
+        sum_sq_ = 0.0;
+        offset_ = T{};
+    }
+
+private:
+    std::array<T, N> values_{};
+    std::size_t window_length_;
+    std::size_t head_ = 0;
+    std::size_t count_ = 0;
+    double sum_ = 0.0;
+    double sum_sq_ = 0.0;
+    T offset_{};
+};
+
+#endif  // ROLLING_WINDOW_HPP
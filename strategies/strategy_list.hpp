@@ -0,0 +1,142 @@
+#ifndef STRATEGY_LIST_HPP
+#define STRATEGY_LIST_HPP
+
+#include <cstddef>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+// Compile-time strategy composition.
+//
+// The strategy "interface" here is a concept, not a base class with virtuals:
+//
+//   onTick(tick)  — called for every market update
+//   onFill(fill)  — called for every execution report
+//
+// StrategyList<S1, S2, ...> holds its strategies by value in a tuple and
+// unrolls dispatch with a fold expression, so a tick flows through every
+// strategy as a chain of direct — and inlinable — calls. There is no vtable
+// and no function pointer anywhere on the per-tick path; a disabled or
+// trivial hook costs literally nothing after inlining, where a virtual
+// plugin layout pays an indirect call per strategy per tick.
+//
+// StrategyBase / RiskManagedStrategy are CRTP building blocks: shared
+// plumbing (default hooks, equity/risk accounting) binds statically to the
+// derived strategy, so the compiler sees the whole tick path as one unit.
+
+namespace strategy_detail {
+
+template <typename S, typename Tick, typename = void>
+struct has_on_tick : std::false_type {};
+template <typename S, typename Tick>
+struct has_on_tick<S, Tick, std::void_t<decltype(std::declval<S&>().onTick(std::declval<const Tick&>()))>>
+    : std::true_type {};
+
+}  // namespace strategy_detail
+
+// CRTP base supplying the concept's default plumbing:
+//  - onTick forwards to the strategy's existing onNewPrice hook, so concrete
+//    strategies keep their natural entry point and still compose;
+//  - onFill defaults to a no-op (and vanishes entirely after inlining).
+// A derived strategy shadows either by defining its own.
+template <typename Derived>
+class StrategyBase {
+public:
+    template <typename Tick>
+    void onTick(const Tick& tick) {
+        derived().onNewPrice(tick);
+    }
+
+    template <typename Fill>
+    void onFill(const Fill&) {}
+
+protected:
+    Derived& derived() { return static_cast<Derived&>(*this); }
+    const Derived& derived() const { return static_cast<const Derived&>(*this); }
+};
+
+// CRTP mixin carrying the risk/equity plumbing every live strategy needs —
+// the state EnhancedMomentumStrategy used to hold via a RiskManager member.
+// Derived calls the protected helpers from its signal logic; everything
+// resolves statically, so the risk gate inlines into the tick path.
+template <typename Derived>
+class RiskManagedStrategy : public StrategyBase<Derived> {
+protected:
+    RiskManagedStrategy(double max_position_size, double max_drawdown, double initial_equity)
+        : max_position_size_(max_position_size), max_drawdown_(max_drawdown),
+          equity_(initial_equity), peak_equity_(initial_equity) {}
+
+    // Gate an entry on the position-size limit.
+    bool riskAllowsEntry(double size) const { return size <= max_position_size_; }
+
+    // True while drawdown from the equity peak stays inside the limit.
+    bool drawdownOk() const {
+        if (peak_equity_ <= 0.0) {
+            return true;
+        }
+        return (peak_equity_ - marked_equity_) / peak_equity_ <= max_drawdown_;
+    }
+
+    // Mark current equity (cash plus open position value) to market.
+    void markToMarket(double open_position_value) {
+        marked_equity_ = equity_ + open_position_value;
+        if (marked_equity_ > peak_equity_) {
+            peak_equity_ = marked_equity_;
+        }
+    }
+
+    void bookEntry(double price, double size) { equity_ -= size * price; }
+    void bookExit(double price, double size) { equity_ += size * price; }
+
+    double maxDrawdown() const { return max_drawdown_; }
+    double equity() const { return equity_; }
+    double markedEquity() const { return marked_equity_; }
+    double peakEquity() const { return peak_equity_; }
+
+    void resetEquity(double initial_equity) {
+        equity_ = initial_equity;
+        peak_equity_ = initial_equity;
+        marked_equity_ = initial_equity;
+    }
+
+private:
+    double max_position_size_;
+    double max_drawdown_;
+    double equity_;
+    double peak_equity_;
+    double marked_equity_ = 0.0;
+};
+
+// Static fan-out: one tick (or fill) flows through every strategy in
+// declaration order via direct calls. Strategies are owned by value.
+template <typename... Strategies>
+class StrategyList {
+public:
+    explicit StrategyList(Strategies... strategies)
+        : strategies_(std::move(strategies)...) {}
+
+    template <typename Tick>
+    void onTick(const Tick& tick) {
+        static_assert((strategy_detail::has_on_tick<Strategies, Tick>::value && ...),
+                      "every strategy in a StrategyList must provide onTick(tick)");
+        std::apply([&](auto&... strategy) { (strategy.onTick(tick), ...); }, strategies_);
+    }
+
+    template <typename Fill>
+    void onFill(const Fill& fill) {
+        std::apply([&](auto&... strategy) { (strategy.onFill(fill), ...); }, strategies_);
+    }
+
+    // Access one strategy by position (reporting, parameter inspection).
+    template <std::size_t I>
+    auto& get() {
+        return std::get<I>(strategies_);
+    }
+
+    static constexpr std::size_t size() { return sizeof...(Strategies); }
+
+private:
+    std::tuple<Strategies...> strategies_;
+};
+
+#endif  // STRATEGY_LIST_HPP
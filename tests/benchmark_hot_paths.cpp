@@ -0,0 +1,195 @@
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <string>
+#include <vector>
+#include "analytics/latency_tracker.hpp"
+#include "execution/broker_api/order_book.hpp"
+#include "execution/order_egress.hpp"
+#include "execution/order_journal.hpp"
+#include "execution/risk_engine.hpp"
+#include "log_utils.h"
+#include "strategies/momentum/rolling_window.hpp"
+#include "utils/symbol_table.hpp"
+
+// Cycle-accurate microbenchmarks for the order and tick hot paths.
+//
+// Bespoke rdtsc harness, no framework dependency: each benchmark body runs
+// per-op inside a serialized timestamp pair and every sample lands in a
+// LatencyHistogram, so the report carries p50/p99/p99.9/max cycles per op —
+// a mean hides exactly the tail we care about. Results print as a table and
+// are written to bench_results.json so two commits can be diffed
+// mechanically (scripts/generate_performance_report.py consumes the same
+// shape).
+//
+// Coverage is the header-resident hot paths: the rolling-window tick kernel
+// behind MovingAverage::addValue / MomentumStrategy::onNewPrice, symbol
+// interning lookups, the RiskEngine pre-trade gate that fronts
+// OrderManager::createOrder, order-journal and log-ring enqueue, the egress
+// coalescing submit, and flat order-book updates/queries. The slab surgery
+// inside OrderManager itself and the connector hand-off still live in
+// translation units with their own main() and get timed end-to-end there.
+//
+// Build and run (the `bench` target in a full checkout does the same):
+//   g++ -std=c++17 -O3 -pthread -I. -Iutils -Iexecution
+//       -Iexecution/broker_api tests/benchmark_hot_paths.cpp -o bench && ./bench
+
+struct BenchResult {
+    std::string name;
+    uint64_t iterations = 0;
+    LatencySnapshot cycles;   // Percentiles in cycles, not ns
+    double ns_per_op_p50 = 0.0;
+};
+
+static std::vector<BenchResult> g_results;
+
+// Run `op` iters times, recording the cost of each call in cycles. The
+// warmup pass pulls code and data into cache so the histogram measures the
+// steady state, not first-touch misses.
+template <typename Op>
+void bench(const std::string& name, uint64_t iters, Op&& op) {
+    constexpr uint64_t WARMUP = 10000;
+    for (uint64_t i = 0; i < WARMUP; ++i) {
+        op(i);
+    }
+    LatencyHistogram hist;
+    for (uint64_t i = 0; i < iters; ++i) {
+        const uint64_t t0 = rdtsc_now();
+        op(i);
+        const uint64_t t1 = rdtsc_now();
+        hist.record(t1 - t0);
+    }
+    BenchResult result;
+    result.name = name;
+    result.iterations = iters;
+    result.cycles = hist.snapshot();
+    result.ns_per_op_p50 = static_cast<double>(LatencyTracker::instance().tscToNs(result.cycles.p50_ns));
+    g_results.push_back(result);
+    std::printf("%-32s %10lu ops  p50 %6lu cy  p99 %6lu cy  p99.9 %6lu cy  max %8lu cy  (~%.0f ns/op)\n",
+                name.c_str(), static_cast<unsigned long>(iters),
+                static_cast<unsigned long>(result.cycles.p50_ns),
+                static_cast<unsigned long>(result.cycles.p99_ns),
+                static_cast<unsigned long>(result.cycles.p999_ns),
+                static_cast<unsigned long>(result.cycles.max_ns),
+                result.ns_per_op_p50);
+}
+
+static void writeJson(const std::string& path) {
+    std::ofstream out(path);
+    out << "{\n  \"benchmarks\": [\n";
+    for (std::size_t i = 0; i < g_results.size(); ++i) {
+        const BenchResult& r = g_results[i];
+        out << "    {\"name\": \"" << r.name << "\", \"iterations\": " << r.iterations
+            << ", \"cycles_p50\": " << r.cycles.p50_ns
+            << ", \"cycles_p99\": " << r.cycles.p99_ns
+            << ", \"cycles_p999\": " << r.cycles.p999_ns
+            << ", \"cycles_max\": " << r.cycles.max_ns
+            << ", \"ns_per_op_p50\": " << r.ns_per_op_p50 << "}"
+            << (i + 1 < g_results.size() ? "," : "") << "\n";
+    }
+    out << "  ]\n}\n";
+}
+
+int main() {
+    constexpr uint64_t ITERS = 1000000;
+    std::cout << "Hot-path microbenchmarks (cycles per op)\n";
+    std::cout << "----------------------------------------------------------------------------------------------------\n";
+
+    // Per-tick rolling kernel: the work inside MovingAverage::addValue and
+    // the window maintenance of MomentumStrategy::onNewPrice.
+    {
+        RollingWindow<double, 256> window(20);
+        double sink = 0.0;
+        bench("rolling_window_push_avg", ITERS, [&](uint64_t i) {
+            window.push(100.0 + static_cast<double>(i & 0xFF) * 0.01);
+            sink += window.average();
+        });
+        if (sink == 0.25) std::cout << sink;  // Keep the result observable
+    }
+
+    // Symbol id lookup on the market-data path.
+    {
+        SymbolTable::instance().intern("AAPL");
+        SymbolTable::instance().intern("GOOG");
+        SymbolTable::instance().intern("MSFT");
+        uint64_t sink = 0;
+        const char* names[3] = {"AAPL", "GOOG", "MSFT"};
+        bench("symbol_table_lookup", ITERS, [&](uint64_t i) {
+            sink += SymbolTable::instance().lookup(names[i % 3]);
+        });
+        if (sink == 1) std::cout << sink;
+    }
+
+    // Pre-trade risk gate fronting createOrder: accept path with limits set,
+    // rebalanced by a fill each round so the reservation counters stay flat.
+    {
+        RiskEngine engine;
+        engine.setSymbolLimits(1, 10000, 100000000, RiskEngine::UNLIMITED, INT32_MAX);
+        uint64_t accepted = 0;
+        bench("risk_engine_check_new_order", ITERS, [&](uint64_t i) {
+            if (engine.checkNewOrder(1, 150.0, 100, (i & 1) != 0) == RiskVerdict::ACCEPT) {
+                ++accepted;
+                engine.onFill(1, 150.0, 100, (i & 1) != 0);
+            }
+        });
+        if (accepted != ITERS + 10000) std::cout << "risk accept anomaly\n";
+    }
+
+    // Order-journal enqueue: the fixed-size binary record into the MPSC ring.
+    {
+        OrderJournal journal("bench_journal.bin");
+        bench("order_journal_record", ITERS, [&](uint64_t i) {
+            journal.record(OrderEventAction::CREATE, static_cast<int>(i), "AAPL",
+                           150.25, 100, 0, 0, true);
+        });
+        std::remove("bench_journal.bin");
+    }
+
+    // LOG() front-end cost with a swallowing sink: format + level gate, no I/O.
+    {
+        log_utils::setLogSink([](LogLevel, const std::string&) {});
+        bench("log_enqueue", ITERS / 10, [&](uint64_t i) {
+            LOG(INFO, "order ", i, " accepted at ", 150.25);
+        });
+    }
+
+    // Egress submit: claim, coalesce, publish. Drain not running, so this
+    // isolates the lock-free submit side (every modify after the first
+    // coalesces into the pending slot).
+    {
+        OrderEgress egress;
+        bench("egress_submit_modify", ITERS, [&](uint64_t i) {
+            egress.submitModify(42, 150.0 + static_cast<double>(i & 0xFF) * 0.01, 100);
+        });
+    }
+
+    // Flat book: apply a tick to a level and read the inside back.
+    {
+        OrderBook book(100);
+        MarketTick tick{};
+        tick.size = 100;
+        uint64_t sink = 0;
+        bench("order_book_apply_best", ITERS, [&](uint64_t i) {
+            tick.price = to_price_ticks(150.0) + static_cast<int64_t>(i % 64) * 100;
+            tick.side = static_cast<uint8_t>(i & 1);
+            book.apply(tick);
+            sink += static_cast<uint64_t>(book.best_bid().price);
+        });
+        if (sink == 1) std::cout << sink;
+    }
+
+    // The measurement primitive itself, so readers can subtract the floor.
+    {
+        LatencyHistogram hist;
+        bench("latency_histogram_record", ITERS, [&](uint64_t i) {
+            hist.record(i & 0xFFFF);
+        });
+    }
+
+    std::cout << "----------------------------------------------------------------------------------------------------\n";
+    writeJson("bench_results.json");
+    std::cout << "Wrote bench_results.json (diff against the previous commit's run)" << std::endl;
+    return 0;
+}
@@ -1,5 +1,7 @@
 #include <iostream>
 #include <fstream>
+#include <atomic>
+#include <cstring>
 #include <mutex>
 #include <string>
 #include <thread>
@@ -7,37 +9,105 @@
 #include <sstream>
 #include <ctime>
 #include <iomanip>
-#include <queue>
-#include <condition_variable>
-#include <map>
+#include <vector>
 #include <filesystem>
+#include "log_utils.h"
+#include "thread_manager.hpp"
 
 namespace fs = std::filesystem;
 
-// Log levels
-enum LogLevel {
-    DEBUG = 0,
-    INFO,
-    WARNING,
-    ERROR,
-    FATAL
-};
-
-// Utility to get current time formatted as a string
-std::string getCurrentTime() {
-    auto now = std::chrono::system_clock::now();
-    std::time_t currentTime = std::chrono::system_clock::to_time_t(now);
+// Utility to format a nanosecond timestamp as a string. Consumer-thread
+// only: producers record a raw clock reading and never touch put_time.
+std::string formatLogTimestamp(uint64_t ns_since_epoch) {
+    std::time_t seconds = static_cast<std::time_t>(ns_since_epoch / 1000000000ULL);
     std::tm timeInfo;
 #ifdef _WIN32
-    localtime_s(&timeInfo, &currentTime);  // Windows-specific localtime
+    localtime_s(&timeInfo, &seconds);  // Windows-specific localtime
 #else
-    localtime_r(&currentTime, &timeInfo);  // POSIX-specific localtime
+    localtime_r(&seconds, &timeInfo);  // POSIX-specific localtime
 #endif
     std::ostringstream oss;
     oss << std::put_time(&timeInfo, "%Y-%m-%d %H:%M:%S");
+    oss << "." << std::setw(3) << std::setfill('0') << (ns_since_epoch / 1000000ULL) % 1000;
     return oss.str();
 }
 
+// One log record as it crosses the ring: a raw timestamp, the level, and
+// either a registered format id with packed numeric args (the hot-site path)
+// or a truncated inline text payload for plain-string call sites. All string
+// assembly happens on the consumer thread.
+struct LogRecord {
+    uint64_t ts_ns;      // Raw clock reading; formatted by the consumer
+    uint32_t format_id;  // 0 = inline text payload, else 1-based registry index
+    LogLevel level;
+    uint8_t arg_count;
+    double args[4];      // Numeric args spliced into the format string
+    char text[192];      // Inline payload (NUL-terminated, truncated)
+};
+
+static_assert(sizeof(LogRecord) <= 256, "LogRecord is copied by value into the ring; keep it small");
+
+// Bounded lock-free multi-producer/single-consumer ring (per-slot sequence
+// numbers, same scheme as the order journal's event ring). Producers claim a
+// slot with one CAS and publish with a release store; the single consumer
+// thread needs no lock at all. When the ring is full the record is dropped
+// and counted — logging must never back-pressure the trading path.
+template <std::size_t Capacity>
+class LogRing {
+    static_assert((Capacity & (Capacity - 1)) == 0, "Capacity must be a power of two");
+
+public:
+    LogRing() : enqueue_pos_(0), dequeue_pos_(0) {
+        for (std::size_t i = 0; i < Capacity; ++i) {
+            slots_[i].seq.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    bool try_push(const LogRecord& record) {
+        std::size_t pos = enqueue_pos_.load(std::memory_order_relaxed);
+        for (;;) {
+            Slot& slot = slots_[pos & (Capacity - 1)];
+            const std::size_t seq = slot.seq.load(std::memory_order_acquire);
+            const intptr_t diff = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos);
+            if (diff == 0) {
+                if (enqueue_pos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    slot.record = record;
+                    slot.seq.store(pos + 1, std::memory_order_release);
+                    return true;
+                }
+            } else if (diff < 0) {
+                return false;  // Ring full
+            } else {
+                pos = enqueue_pos_.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    // Single consumer only.
+    bool try_pop(LogRecord& out) {
+        const std::size_t pos = dequeue_pos_;
+        Slot& slot = slots_[pos & (Capacity - 1)];
+        const std::size_t seq = slot.seq.load(std::memory_order_acquire);
+        if (static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos + 1) < 0) {
+            return false;  // Ring empty
+        }
+        out = slot.record;
+        slot.seq.store(pos + Capacity, std::memory_order_release);
+        dequeue_pos_ = pos + 1;
+        return true;
+    }
+
+private:
+    struct Slot {
+        std::atomic<std::size_t> seq;
+        LogRecord record;
+    };
+
+    alignas(64) Slot slots_[Capacity];
+    alignas(64) std::atomic<std::size_t> enqueue_pos_;
+    alignas(64) std::size_t dequeue_pos_;  // Consumer-private
+};
+
 // Logger Class
 class Logger {
 public:
@@ -64,30 +134,83 @@ public:
         checkLogRotation();
     }
 
-    // Log messages of various levels
+    // Register a format string once at startup and log by id afterwards, so
+    // hot sites never carry a std::string through the ring. "{}" placeholders
+    // are spliced with the numeric args on the consumer thread.
+    uint32_t registerFormat(const std::string& format) {
+        std::lock_guard<std::mutex> lock(formatMutex);
+        formats.push_back(format);
+        return static_cast<uint32_t>(formats.size());  // Ids are 1-based; 0 means inline text
+    }
+
+    // Hot-site entry: level, registered format id, up to four numeric args.
+    // The level filter runs before any other work; past it, the cost is one
+    // record copy into the ring — no formatting, no allocation, no lock.
+    void log(LogLevel level, uint32_t format_id, const double* args = nullptr, uint8_t arg_count = 0) {
+        if (level < currentLogLevel.load(std::memory_order_relaxed)) {
+            return;
+        }
+        LogRecord record{};
+        record.ts_ns = nowNs();
+        record.format_id = format_id;
+        record.level = level;
+        record.arg_count = arg_count > 4 ? 4 : arg_count;
+        for (uint8_t i = 0; i < record.arg_count; ++i) {
+            record.args[i] = args[i];
+        }
+        push(record);
+    }
+
+    // Plain-string entry for cold paths. Still cheap: the level check comes
+    // first, and the only producer-side work is one bounded memcpy.
     void log(LogLevel level, const std::string& message) {
-        std::lock_guard<std::mutex> lock(queueMutex);
-        logQueue.push(formatLogMessage(level, message));
-        queueCondition.notify_one();
+        if (level < currentLogLevel.load(std::memory_order_relaxed)) {
+            return;
+        }
+        LogRecord record{};
+        record.ts_ns = nowNs();
+        record.format_id = 0;
+        record.level = level;
+        record.arg_count = 0;
+        const std::size_t n = message.size() < sizeof(record.text) - 1 ? message.size() : sizeof(record.text) - 1;
+        std::memcpy(record.text, message.data(), n);
+        record.text[n] = '\0';
+        push(record);
     }
 
     // Set the logging level to filter messages
     void setLogLevel(LogLevel level) {
-        std::lock_guard<std::mutex> lock(levelMutex);
-        currentLogLevel = level;
+        currentLogLevel.store(level, std::memory_order_relaxed);
+        log_utils::setLogLevel(level);  // Keep the LOG() front-end gate in step
+    }
+
+    // Install this Logger as the back-end for the LOG() macro front-end in
+    // log_utils.h, replacing the early-init stderr fallback.
+    void installAsSink() {
+        log_utils::setLogSink(&Logger::sinkEntry);
+    }
+
+    // Records lost to ring overflow since startup.
+    uint64_t droppedRecords() const {
+        return droppedCount.load(std::memory_order_relaxed);
     }
 
     // Stop the logging thread
     void stop() {
-        running = false;
-        queueCondition.notify_all();
+        running.store(false, std::memory_order_relaxed);
         if (logThread.joinable()) {
             logThread.join();
         }
     }
 
 private:
-    Logger() : running(true), logThread(&Logger::processLogQueue, this), currentLogLevel(INFO) {}
+    static constexpr std::size_t RING_CAPACITY = 1 << 15;
+    static constexpr std::size_t FLUSH_BATCH = 128;  // Records between stream flushes
+    static constexpr std::chrono::milliseconds FLUSH_INTERVAL{50};
+
+    Logger() : running(true), currentLogLevel(INFO), droppedCount(0),
+               logThread(ThreadManager::instance().launch(ThreadRole::LOGGER,
+                                                          [this] { processLogQueue(); })) {}
 
     ~Logger() {
         stop();
@@ -96,48 +219,102 @@ private:
         }
     }
 
-    std::string formatLogMessage(LogLevel level, const std::string& message) {
-        if (level < currentLogLevel) {
-            return "";  // Skip log messages below the set log level
+    static void sinkEntry(LogLevel level, const std::string& message) {
+        getInstance().log(level, message);
+    }
+
+    static uint64_t nowNs() {
+        return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::system_clock::now().time_since_epoch()).count());
+    }
+
+    void push(const LogRecord& record) {
+        if (!ring.try_push(record)) {
+            // Overflow policy: drop and count. A logging burst is allowed to
+            // widen a gap in the log, never the tick-to-trade distribution.
+            droppedCount.fetch_add(1, std::memory_order_relaxed);
         }
+    }
 
+    // Turn a binary record back into a log line. Consumer thread only.
+    std::string formatLogRecord(const LogRecord& record) {
         std::ostringstream oss;
-        oss << "[" << getCurrentTime() << "] ";
-        switch (level) {
+        oss << "[" << formatLogTimestamp(record.ts_ns) << "] ";
+        switch (record.level) {
             case DEBUG: oss << "[DEBUG] "; break;
             case INFO: oss << "[INFO] "; break;
             case WARNING: oss << "[WARNING] "; break;
             case ERROR: oss << "[ERROR] "; break;
             case FATAL: oss << "[FATAL] "; break;
         }
-        oss << message;
+        if (record.format_id == 0) {
+            oss << record.text;
+        } else {
+            std::string format;
+            {
+                std::lock_guard<std::mutex> lock(formatMutex);
+                if (record.format_id <= formats.size()) {
+                    format = formats[record.format_id - 1];
+                }
+            }
+            std::size_t arg = 0;
+            std::size_t from = 0;
+            for (;;) {
+                const std::size_t at = format.find("{}", from);
+                if (at == std::string::npos || arg >= record.arg_count) {
+                    oss << format.substr(from);
+                    break;
+                }
+                oss << format.substr(from, at - from) << record.args[arg++];
+                from = at + 2;
+            }
+        }
         return oss.str();
     }
 
-    // Process log queue in a separate thread
+    // Drain the ring in a separate thread: batched, buffered writes with a
+    // periodic flush rather than a stream flush per line.
     void processLogQueue() {
-        while (running) {
-            std::unique_lock<std::mutex> lock(queueMutex);
-            queueCondition.wait(lock, [this] { return !logQueue.empty() || !running; });
-
-            while (!logQueue.empty()) {
-                std::string logMessage = logQueue.front();
-                logQueue.pop();
-                lock.unlock();
-                if (!logMessage.empty()) {
-                    writeToLogFile(logMessage);
+        LogRecord record;
+        std::size_t sinceFlush = 0;
+        auto lastFlush = std::chrono::steady_clock::now();
+
+        while (running.load(std::memory_order_relaxed)) {
+            bool wrote = false;
+            while (ring.try_pop(record)) {
+                writeToLogFile(formatLogRecord(record));
+                wrote = true;
+                if (++sinceFlush >= FLUSH_BATCH) {
+                    flushLogFile();
+                    sinceFlush = 0;
+                    lastFlush = std::chrono::steady_clock::now();
+                }
+            }
+            if (!wrote) {
+                const auto now = std::chrono::steady_clock::now();
+                if (sinceFlush > 0 && now - lastFlush >= FLUSH_INTERVAL) {
+                    flushLogFile();
+                    sinceFlush = 0;
+                    lastFlush = now;
                 }
-                lock.lock();
+                std::this_thread::sleep_for(std::chrono::microseconds(200));
             }
         }
+
+        // Final drain on shutdown
+        while (ring.try_pop(record)) {
+            writeToLogFile(formatLogRecord(record));
+        }
+        flushLogFile();
     }
 
-    // Write log message to file
+    // Write log message to file. '\n', not std::endl — flushing is a policy
+    // decision made by the drain loop, not a side effect of every line.
     void writeToLogFile(const std::string& logMessage) {
         std::lock_guard<std::mutex> lock(fileMutex);
 
         if (logFile.is_open()) {
-            logFile << logMessage << std::endl;
+            logFile << logMessage << '\n';
             currentFileSize += logMessage.size();
             checkLogRotation();
         } else {
@@ -145,6 +322,13 @@ private:
         }
     }
 
+    void flushLogFile() {
+        std::lock_guard<std::mutex> lock(fileMutex);
+        if (logFile.is_open()) {
+            logFile.flush();
+        }
+    }
+
     // Rotate log files if needed
     void checkLogRotation() {
         if (currentFileSize > maxFileSize) {
@@ -169,11 +353,10 @@ private:
         fs::rename(logFileName, backupFile);
     }
 
-    std::mutex queueMutex;
+    LogRing<RING_CAPACITY> ring;
     std::mutex fileMutex;
-    std::mutex levelMutex;
-    std::condition_variable queueCondition;
-    std::queue<std::string> logQueue;
+    std::mutex formatMutex;
+    std::vector<std::string> formats;
     std::ofstream logFile;
 
     std::size_t maxFileSize;
@@ -181,8 +364,9 @@ private:
     int maxBackupCount;
 
     std::string logFileName;
-    bool running;
-    LogLevel currentLogLevel;
+    std::atomic<bool> running;
+    std::atomic<LogLevel> currentLogLevel;
+    std::atomic<uint64_t> droppedCount;
     std::thread logThread;
 };
 
@@ -191,6 +375,7 @@ int main() {
     Logger& logger = Logger::getInstance();
     logger.setLogFile("system.log", 10, 5);  // Log file size of 10MB, max 5 backup files
     logger.setLogLevel(DEBUG);  // Set logging level to DEBUG
+    logger.installAsSink();     // Route LOG() macro sites through the ring
 
     // Log messages of different severity
     logger.log(DEBUG, "Debugging system initialization.");
@@ -199,11 +384,22 @@ int main() {
     logger.log(ERROR, "Error connecting to database.");
     logger.log(FATAL, "Critical system failure.");
 
+    // Hot-site style: register the format once, then log by id with args
+    uint32_t orderFormat = logger.registerFormat("Order {} executed at price {}");
+    double args[2] = {42.0, 150.25};
+    logger.log(INFO, orderFormat, args, 2);
+
+    // Macro front-end: lazily formatted, compile-time strippable sites
+    LOG(INFO, "Fill received for order ", 42, " at ", 150.25);
+    LOG(DEBUG, "This site vanishes entirely when LOG_COMPILE_MIN_LEVEL > DEBUG");
+
     // Simulate delay
     std::this_thread::sleep_for(std::chrono::seconds(2));
 
+    std::cout << "Dropped log records: " << logger.droppedRecords() << std::endl;
+
     // Stop the logger
     logger.stop();
 
     return 0;
-}
\ No newline at end of file
+}
@@ -0,0 +1,120 @@
+#ifndef LOG_UTILS_H
+#define LOG_UTILS_H
+
+#include <atomic>
+#include <iostream>
+#include <sstream>
+#include <string>
+
+// Logging front-end shared by the hot-path translation units.
+//
+// Two gates stand in front of every log site:
+//
+//   1. Compile-time: sites below LOG_COMPILE_MIN_LEVEL are discarded by
+//      `if constexpr` — no argument evaluation, no branch, no code at all.
+//      Release builds pass -DLOG_COMPILE_MIN_LEVEL=LOG_LEVEL_INFO (or higher)
+//      to strip DEBUG sites from the binary outright.
+//
+//   2. Runtime: surviving sites check the atomic runtime level before any
+//      argument formatting. A filtered message costs one relaxed load and a
+//      predicted branch; the ostringstream work only happens for messages
+//      that will actually be emitted.
+//
+// The back-end is pluggable: the ring-buffer Logger (log_utils.cpp) installs
+// itself as the sink at startup; until then messages fall back to stderr so
+// early-init logging is never lost.
+
+enum LogLevel {
+    DEBUG = 0,
+    INFO,
+    WARNING,
+    ERROR,
+    FATAL
+};
+
+// Numeric aliases usable in -D flags and preprocessor comparisons.
+#define LOG_LEVEL_DEBUG 0
+#define LOG_LEVEL_INFO 1
+#define LOG_LEVEL_WARNING 2
+#define LOG_LEVEL_ERROR 3
+#define LOG_LEVEL_FATAL 4
+
+#ifndef LOG_COMPILE_MIN_LEVEL
+#define LOG_COMPILE_MIN_LEVEL LOG_LEVEL_DEBUG
+#endif
+
+namespace log_utils {
+
+using LogSink = void (*)(LogLevel, const std::string&);
+
+namespace detail {
+
+inline std::atomic<int>& runtimeLevel() {
+    static std::atomic<int> level{LOG_LEVEL_INFO};
+    return level;
+}
+
+inline std::atomic<LogSink>& sink() {
+    static std::atomic<LogSink> s{nullptr};
+    return s;
+}
+
+inline void deliver(LogLevel level, const std::string& message) {
+    LogSink s = sink().load(std::memory_order_acquire);
+    if (s != nullptr) {
+        s(level, message);
+    } else {
+        std::cerr << message << std::endl;  // Early-init fallback
+    }
+}
+
+// Builds the message lazily — only reached after both gates pass.
+template <typename... Args>
+inline void emit(LogLevel level, Args&&... args) {
+    std::ostringstream oss;
+    (oss << ... << args);
+    deliver(level, oss.str());
+}
+
+}  // namespace detail
+
+// Route emitted messages to a back-end (the ring-buffer Logger). Thread-safe.
+inline void setLogSink(LogSink sink) {
+    detail::sink().store(sink, std::memory_order_release);
+}
+
+// Runtime filter for the sites that survived the compile-time gate.
+inline void setLogLevel(LogLevel level) {
+    detail::runtimeLevel().store(level, std::memory_order_relaxed);
+}
+
+// Plain function entries for cold paths and existing call sites. The level
+// check still precedes all formatting done by the caller's string arithmetic
+// only at the site itself; prefer the LOG() macro on anything warm.
+inline void log(LogLevel level, const std::string& message) {
+    if (static_cast<int>(level) < detail::runtimeLevel().load(std::memory_order_relaxed)) {
+        return;
+    }
+    detail::deliver(level, message);
+}
+
+inline void log(const std::string& message) {
+    log(INFO, message);
+}
+
+}  // namespace log_utils
+
+// Stream-style log site: LOG(WARNING, "Order ", id, " rejected"). Arguments
+// are not evaluated unless the site is compiled in AND passes the runtime
+// level — a disabled DEBUG line costs nothing in release builds.
+#define LOG(level, ...)                                                                   \
+    do {                                                                                  \
+        if constexpr (static_cast<int>(level) >= LOG_COMPILE_MIN_LEVEL) {                 \
+            if (static_cast<int>(level) >=                                                \
+                log_utils::detail::runtimeLevel().load(std::memory_order_relaxed)) {      \
+                log_utils::detail::emit((level), __VA_ARGS__);                            \
+            }                                                                             \
+        }                                                                                 \
+    } while (0)
+
+#endif  // LOG_UTILS_H
@@ -0,0 +1,136 @@
+#ifndef SYMBOL_TABLE_HPP
+#define SYMBOL_TABLE_HPP
+
+#include <atomic>
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <mutex>
+#include <string>
+
+// Process-wide symbol interning table.
+//
+// Symbols travel the hot paths as dense uint32 ids, not std::strings: an id
+// compare is one integer op, an id copy allocates nothing, and ids index
+// straight into flat per-symbol arrays (subscription tables, books, risk
+// slots). A ticker is padded into one 8-byte word and interned once at
+// subscription/startup into a fixed-capacity open-addressing hash (FNV-1a of
+// the padded word, linear probing, power-of-two slots); lookups afterwards
+// are lock-free reads. The reverse id-to-name mapping exists for logging and
+// reports only — nothing hot should ever need the characters back.
+class SymbolTable {
+public:
+    static constexpr uint32_t MAX_SYMBOLS = 1024;
+    static constexpr uint32_t INVALID_SYMBOL = UINT32_MAX;
+    static constexpr std::size_t MAX_NAME_LEN = 8;  // Padded 8-byte key
+
+    static SymbolTable& instance() {
+        static SymbolTable table;
+        return table;
+    }
+
+    SymbolTable(const SymbolTable&) = delete;
+    SymbolTable& operator=(const SymbolTable&) = delete;
+
+    // Intern a symbol, returning its dense id (existing id if already
+    // interned). Mutex-guarded — interning happens at startup and on
+    // subscription, never per message. Names longer than 8 chars truncate.
+    uint32_t intern(const char* name) {
+        const uint64_t key = packKey(name);
+        std::lock_guard<std::mutex> lock(intern_mutex_);
+        std::size_t slot = slotOf(key);
+        for (;;) {
+            const uint64_t existing = slots_[slot].key.load(std::memory_order_acquire);
+            if (existing == key) {
+                return slots_[slot].id;
+            }
+            if (existing == EMPTY_KEY) {
+                break;
+            }
+            slot = (slot + 1) & (NUM_SLOTS - 1);
+        }
+        const uint32_t id = count_.load(std::memory_order_relaxed);
+        if (id >= MAX_SYMBOLS) {
+            return INVALID_SYMBOL;  // Table full: a sizing bug, surfaced loudly
+        }
+        std::memcpy(names_[id].data(), &key, sizeof(key));
+        slots_[slot].id = id;
+        // Publish the id before the key: a concurrent lock-free lookup that
+        // sees the key is guaranteed to see the id.
+        slots_[slot].key.store(key, std::memory_order_release);
+        count_.store(id + 1, std::memory_order_release);
+        return id;
+    }
+
+    uint32_t intern(const std::string& name) { return intern(name.c_str()); }
+
+    // Lock-free lookup of an already-interned symbol. Returns INVALID_SYMBOL
+    // if the name was never interned.
+    uint32_t lookup(const char* name) const {
+        const uint64_t key = packKey(name);
+        std::size_t slot = slotOf(key);
+        for (std::size_t probes = 0; probes < NUM_SLOTS; ++probes) {
+            const uint64_t existing = slots_[slot].key.load(std::memory_order_acquire);
+            if (existing == key) {
+                return slots_[slot].id;
+            }
+            if (existing == EMPTY_KEY) {
+                return INVALID_SYMBOL;
+            }
+            slot = (slot + 1) & (NUM_SLOTS - 1);
+        }
+        return INVALID_SYMBOL;
+    }
+
+    uint32_t lookup(const std::string& name) const { return lookup(name.c_str()); }
+
+    // Cold-path reverse lookup for logging/reporting. NUL-terminated.
+    const char* name(uint32_t id) const {
+        if (id >= count_.load(std::memory_order_acquire)) {
+            return "?";
+        }
+        return names_[id].data();
+    }
+
+    uint32_t size() const { return count_.load(std::memory_order_acquire); }
+
+private:
+    static constexpr std::size_t NUM_SLOTS = 4096;  // 4x headroom over MAX_SYMBOLS
+    static constexpr uint64_t EMPTY_KEY = 0;
+
+    SymbolTable() = default;
+
+    // Pad the symbol into one little-endian 8-byte word. A one-character
+    // difference anywhere in the name changes the whole key.
+    static uint64_t packKey(const char* name) {
+        char padded[MAX_NAME_LEN] = {};
+        for (std::size_t i = 0; i < MAX_NAME_LEN && name[i] != '\0'; ++i) {
+            padded[i] = name[i];
+        }
+        uint64_t key;
+        std::memcpy(&key, padded, sizeof(key));
+        return key != EMPTY_KEY ? key : 0x20;  // Map "" to " " so 0 stays the empty sentinel
+    }
+
+    static std::size_t slotOf(uint64_t key) {
+        // FNV-1a over the key's 8 bytes.
+        uint64_t hash = 14695981039346656037ULL;
+        for (int i = 0; i < 8; ++i) {
+            hash ^= (key >> (i * 8)) & 0xFF;
+            hash *= 1099511628211ULL;
+        }
+        return static_cast<std::size_t>(hash) & (NUM_SLOTS - 1);
+    }
+
+    struct Slot {
+        std::atomic<uint64_t> key{EMPTY_KEY};
+        uint32_t id = 0;
+    };
+
+    std::array<Slot, NUM_SLOTS> slots_;
+    std::array<std::array<char, MAX_NAME_LEN + 1>, MAX_SYMBOLS> names_{};  // Reverse table
+    std::atomic<uint32_t> count_{0};
+    std::mutex intern_mutex_;
+};
+
+#endif  // SYMBOL_TABLE_HPP
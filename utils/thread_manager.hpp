@@ -0,0 +1,323 @@
+#ifndef THREAD_MANAGER_HPP
+#define THREAD_MANAGER_HPP
+
+#include <pthread.h>
+#include <sched.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <utility>
+
+// Placement control for every engine thread.
+//
+// Threads used to be spawned bare, so the kernel was free to migrate the
+// feed reader across sockets mid-burst — on a dual-socket host that costs
+// 2-3x on p99.9 tick-to-trade. ThreadManager gives each thread a named role
+// and launches it with the placement the config assigns to that role:
+//
+//   threading:
+//     feed:         { cpu: 2, policy: fifo, wait: spin, numa_node: 0 }
+//     strategy:     { cpu: 3, policy: fifo, wait: spin, numa_node: 0 }
+//     ...
+//
+// cpu pins with pthread_setaffinity_np; policy "fifo" requests SCHED_FIFO
+// (falling back with a report line when the process lacks CAP_SYS_NICE);
+// wait "spin" tells the role's loop to busy-poll instead of sleeping, which
+// the loop queries through busySpin()/pauseOrYield(). NUMA locality comes
+// from first-touch: allocateLocal() maps and faults pages from the calling
+// thread after it is pinned, so a role's arenas and rings land on its own
+// node without a libnuma dependency.
+//
+// printPlacementReport() logs what was asked for and what actually took
+// effect, so a mis-deployed box is visible at startup rather than in the
+// latency histograms.
+
+enum class ThreadRole : int {
+    FEED = 0,
+    STRATEGY,
+    ORDER_EGRESS,
+    LOGGER,
+    BACKGROUND,
+    ROLE_COUNT
+};
+
+inline const char* threadRoleName(ThreadRole role) {
+    switch (role) {
+        case ThreadRole::FEED: return "feed";
+        case ThreadRole::STRATEGY: return "strategy";
+        case ThreadRole::ORDER_EGRESS: return "order-egress";
+        case ThreadRole::LOGGER: return "logger";
+        case ThreadRole::BACKGROUND: return "background";
+        default: return "unknown";
+    }
+}
+
+class ThreadManager {
+public:
+    static constexpr int NUM_ROLES = static_cast<int>(ThreadRole::ROLE_COUNT);
+
+    struct RoleConfig {
+        int cpu = -1;            // -1 = unpinned
+        bool fifo = false;       // Request SCHED_FIFO
+        int priority = 80;       // FIFO priority when granted
+        bool busy_spin = false;  // Role's loops poll instead of sleeping
+        int numa_node = -1;      // Documented intent; locality is first-touch
+    };
+
+    static ThreadManager& instance() {
+        static ThreadManager manager;
+        return manager;
+    }
+
+    // Parse the threading: section of the engine config. Only the flat
+    // role/key/value shape above is understood — this is a section reader,
+    // not a YAML parser — and an absent file or section leaves every role
+    // at its bare default, which matches the old behaviour.
+    bool loadConfig(const std::string& path) {
+        std::ifstream in(path);
+        if (!in.is_open()) {
+            return false;
+        }
+        std::string line;
+        bool in_threading = false;
+        int current_role = -1;
+        while (std::getline(in, line)) {
+            const std::string stripped = strip(line);
+            if (stripped.empty() || stripped[0] == '#') {
+                continue;
+            }
+            if (indentOf(line) == 0) {
+                in_threading = (stripped == "threading:");
+                current_role = -1;
+                continue;
+            }
+            if (!in_threading) {
+                continue;
+            }
+            if (indentOf(line) == 2 && stripped.back() == ':') {
+                current_role = roleIndex(stripped.substr(0, stripped.size() - 1));
+                continue;
+            }
+            // Accept both nested "key: value" lines and the inline
+            // "role: { cpu: 2, policy: fifo }" flow style.
+            if (current_role >= 0) {
+                applyKeyValues(roles_[current_role], stripped);
+            } else if (stripped.find('{') != std::string::npos) {
+                const std::size_t colon = stripped.find(':');
+                const int role = roleIndex(strip(stripped.substr(0, colon)));
+                if (role >= 0) {
+                    applyKeyValues(roles_[role], stripped.substr(colon + 1));
+                }
+            }
+        }
+        configured_ = true;
+        return true;
+    }
+
+    void setRoleConfig(ThreadRole role, const RoleConfig& config) {
+        roles_[static_cast<int>(role)] = config;
+        configured_ = true;
+    }
+
+    const RoleConfig& roleConfig(ThreadRole role) const {
+        return roles_[static_cast<int>(role)];
+    }
+
+    // Spawn a thread under a role: the wrapper names it, pins it, requests
+    // its scheduling class, then runs the body — so everything the body
+    // allocates first-touches on the right node.
+    template <typename Fn>
+    std::thread launch(ThreadRole role, Fn&& fn) {
+        return std::thread([this, role, body = std::forward<Fn>(fn)]() mutable {
+            applyPlacement(role);
+            body();
+        });
+    }
+
+    // Apply the role's placement to the calling thread (for threads whose
+    // lifetime we do not own, e.g. main acting as the strategy thread).
+    void applyPlacement(ThreadRole role) {
+        const int idx = static_cast<int>(role);
+        const RoleConfig& config = roles_[idx];
+        Placement& placement = placements_[idx];
+        placement.requested = config;
+        placement.launched = true;
+
+        pthread_setname_np(pthread_self(), threadRoleName(role));
+
+        if (config.cpu >= 0) {
+            cpu_set_t set;
+            CPU_ZERO(&set);
+            CPU_SET(config.cpu, &set);
+            placement.pinned =
+                pthread_setaffinity_np(pthread_self(), sizeof(set), &set) == 0;
+        }
+        if (config.fifo) {
+            sched_param param{};
+            param.sched_priority = config.priority;
+            placement.fifo_granted =
+                pthread_setscheduler_wrapper(SCHED_FIFO, &param);
+        }
+    }
+
+    // Wait-policy query for a role's event loop.
+    bool busySpin(ThreadRole role) const {
+        return roles_[static_cast<int>(role)].busy_spin;
+    }
+
+    // One idle step honouring the role's wait policy: a pipeline pause when
+    // spinning, a real sleep otherwise.
+    void pauseOrYield(ThreadRole role) const {
+        if (busySpin(role)) {
+#if defined(__x86_64__) || defined(__i386__)
+            __builtin_ia32_pause();
+#else
+            std::this_thread::yield();
+#endif
+        } else {
+            std::this_thread::sleep_for(std::chrono::microseconds(50));
+        }
+    }
+
+    // NUMA-local arena for the calling (pinned) thread: mmap plus a touch of
+    // every page, so first-touch policy places it on the thread's node.
+    static void* allocateLocal(std::size_t bytes) {
+        void* mem = mmap(nullptr, bytes, PROT_READ | PROT_WRITE,
+                         MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (mem == MAP_FAILED) {
+            return nullptr;
+        }
+        const long page = sysconf(_SC_PAGESIZE);
+        for (std::size_t off = 0; off < bytes; off += static_cast<std::size_t>(page)) {
+            static_cast<volatile char*>(mem)[off] = 0;
+        }
+        return mem;
+    }
+
+    static void freeLocal(void* mem, std::size_t bytes) {
+        if (mem != nullptr) {
+            munmap(mem, bytes);
+        }
+    }
+
+    // Startup placement report: requested vs achieved, per launched role.
+    void printPlacementReport(std::ostream& out = std::cout) const {
+        out << "[THREAD MANAGER] Placement report"
+            << (configured_ ? "" : " (no threading config loaded; all roles bare)") << "\n";
+        for (int i = 0; i < NUM_ROLES; ++i) {
+            const Placement& p = placements_[i];
+            const RoleConfig& c = roles_[i];
+            out << "  " << threadRoleName(static_cast<ThreadRole>(i)) << ": ";
+            if (!p.launched) {
+                out << "not launched\n";
+                continue;
+            }
+            if (c.cpu >= 0) {
+                out << "cpu " << c.cpu << (p.pinned ? " (pinned)" : " (PIN FAILED)");
+            } else {
+                out << "unpinned";
+            }
+            if (c.fifo) {
+                out << ", SCHED_FIFO prio " << c.priority
+                    << (p.fifo_granted ? " (granted)" : " (DENIED, running SCHED_OTHER)");
+            }
+            out << ", wait=" << (c.busy_spin ? "spin" : "sleep");
+            if (c.numa_node >= 0) {
+                out << ", numa node " << c.numa_node << " (first-touch)";
+            }
+            out << "\n";
+        }
+    }
+
+private:
+    struct Placement {
+        RoleConfig requested;
+        bool launched = false;
+        bool pinned = false;
+        bool fifo_granted = false;
+    };
+
+    ThreadManager() = default;
+
+    static bool pthread_setscheduler_wrapper(int policy, const sched_param* param) {
+        return pthread_setschedparam(pthread_self(), policy, param) == 0;
+    }
+
+    static int roleIndex(const std::string& name) {
+        for (int i = 0; i < NUM_ROLES; ++i) {
+            if (name == threadRoleName(static_cast<ThreadRole>(i))) {
+                return i;
+            }
+        }
+        return -1;
+    }
+
+    static std::size_t indentOf(const std::string& line) {
+        std::size_t i = 0;
+        while (i < line.size() && line[i] == ' ') {
+            ++i;
+        }
+        return i;
+    }
+
+    static std::string strip(const std::string& s) {
+        std::size_t begin = s.find_first_not_of(" \t\r");
+        if (begin == std::string::npos) {
+            return "";
+        }
+        std::size_t end = s.find_last_not_of(" \t\r");
+        return s.substr(begin, end - begin + 1);
+    }
+
+    // Apply "cpu: 2, policy: fifo, wait: spin, numa_node: 0" (braces and
+    // trailing comments tolerated) onto a role config.
+    static void applyKeyValues(RoleConfig& config, const std::string& text) {
+        std::string cleaned;
+        for (char ch : text) {
+            if (ch == '{' || ch == '}') {
+                continue;
+            }
+            if (ch == '#') {
+                break;
+            }
+            cleaned.push_back(ch == ',' ? '\n' : ch);
+        }
+        std::istringstream in(cleaned);
+        std::string item;
+        while (std::getline(in, item)) {
+            const std::size_t colon = item.find(':');
+            if (colon == std::string::npos) {
+                continue;
+            }
+            const std::string key = strip(item.substr(0, colon));
+            const std::string value = strip(item.substr(colon + 1));
+            if (value.empty()) {
+                continue;
+            }
+            if (key == "cpu") {
+                config.cpu = std::stoi(value);
+            } else if (key == "policy") {
+                config.fifo = (value == "fifo");
+            } else if (key == "priority") {
+                config.priority = std::stoi(value);
+            } else if (key == "wait") {
+                config.busy_spin = (value == "spin");
+            } else if (key == "numa_node") {
+                config.numa_node = std::stoi(value);
+            }
+        }
+    }
+
+    RoleConfig roles_[NUM_ROLES];
+    Placement placements_[NUM_ROLES];
+    bool configured_ = false;
+};
+
+#endif  // THREAD_MANAGER_HPP